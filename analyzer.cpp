@@ -2,194 +2,641 @@
 #include <cassert>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <sstream>
+#include <thread>
+
 #include "analyzer.h"
+#include "slot_aliases.h"
+
+
+// Rule of productions.csv that checks a unary operation on a term.
+static constexpr int UNARY_OPERATION_RULE = 88;
+
+
+struct BinaryOperator {
+    // From 1, for ||, to 5, for the multiplicative operators; 0 when the
+    // token is not a binary operator.
+    int precedence;
+    Operation operation;
+};
+
+
+// The operators of LV1OPER to LV5OPER, and the operations their rules set.
+static constexpr std::array<BinaryOperator, Token::ERROR + 1> make_binary_operators() {
+    std::array<BinaryOperator, Token::ERROR + 1> operators{};
+    for (auto &binary : operators)
+        binary = {0, Operation::NONE};
+    operators[Token::OR] = {1, Operation::OR};
+    operators[Token::AND] = {2, Operation::AND};
+    operators[Token::EQ] = {3, Operation::EQ};
+    operators[Token::NEQ] = {3, Operation::NEQ};
+    operators[Token::LT] = {3, Operation::LT};
+    operators[Token::GT] = {3, Operation::GT};
+    operators[Token::LTE] = {3, Operation::LTE};
+    operators[Token::GTE] = {3, Operation::GTE};
+    operators[Token::PLUS] = {4, Operation::ADD};
+    operators[Token::MINUS] = {4, Operation::SUBS};
+    operators[Token::BW_OR] = {4, Operation::BW_OR};
+    operators[Token::BW_XOR_NEG] = {4, Operation::BW_XOR};
+    operators[Token::TIMES] = {5, Operation::MULT};
+    operators[Token::DIV] = {5, Operation::DIV};
+    operators[Token::MOD] = {5, Operation::MOD};
+    operators[Token::BW_AND] = {5, Operation::BW_AND};
+    operators[Token::BW_AND_NOT] = {5, Operation::BW_AND_NOT};
+    operators[Token::L_SHIFT] = {5, Operation::L_SHIFT};
+    operators[Token::R_SHIFT] = {5, Operation::R_SHIFT};
+    return operators;
+}
+
+static constexpr auto binary_operators = make_binary_operators();
 
 
 Analyzer::Analyzer(LexicalAnalyzer *lexical_analyzer) :
-        lexical_analyzer(lexical_analyzer), context() {
-    std::string line, symbol;
-
-    std::ifstream productions_file("productions.csv");
-    getline(productions_file, line);
-    while (line.size()) {
-        std::stringstream ss(line);
-        std::vector<ProductionItem> production;
-        getline(ss, symbol, ',');
-        while (not ss.eof()) {
-            getline(ss, symbol, ',');
-            if (symbol.size())
-                production.push_back(_parse_production_item(symbol));
-        }
-        productions.push_back(production);
-        getline(productions_file, line);
-    }
+        lexical_analyzer(lexical_analyzer), token_buffer(nullptr), pipelined_lexer(nullptr),
+        next_gap(0), gap_start(SIZE_MAX), standard_error(&std::cerr),
+        diagnostics(&standard_error),
+        context(lexical_analyzer->get_interner()), found_errors(false), recovering(false),
+        rule_trace(nullptr), ast(nullptr), tree(nullptr) {
+}
 
-    std::ifstream syntactic_table_file("syntactic_table.csv");
-    getline(syntactic_table_file, line);
-    getline(syntactic_table_file, line);
-    for (int row_count = 0; line.size(); ++row_count) {
-        std::stringstream ss(line);
-        std::map<Token, int> row;
-        getline(ss, symbol, ',');
-#ifdef DEBUG
-        assert(SyntaxSymbol(symbol) == row_count + SyntaxSymbol::FIRST_NON_TERMINAL);
-#endif
-        for (int token = 0; not ss.eof(); ++token) {
-            getline(ss, symbol, ',');
-            if (symbol.size()) {
-                std::stringstream(symbol) >> row[token];
-                --row[token];
-#ifdef DEBUG
-                assert(row[token] < productions.size());
-                assert(token < SyntaxSymbol::FIRST_NON_TERMINAL);
-#endif
+
+Analyzer::Analyzer(TokenBuffer *token_buffer) :
+        lexical_analyzer(nullptr), token_buffer(token_buffer), pipelined_lexer(nullptr),
+        next_gap(0), gap_start(SIZE_MAX), standard_error(&std::cerr),
+        diagnostics(&standard_error),
+        context(token_buffer->get_interner()), found_errors(false), recovering(false),
+        rule_trace(nullptr), ast(nullptr), tree(nullptr) {
+}
+
+
+Analyzer::Analyzer(PipelinedLexer *pipelined_lexer) :
+        lexical_analyzer(nullptr), token_buffer(nullptr), pipelined_lexer(pipelined_lexer),
+        next_gap(0), gap_start(SIZE_MAX), standard_error(&std::cerr),
+        diagnostics(&standard_error),
+        context(pipelined_lexer->get_interner()), found_errors(false), recovering(false),
+        rule_trace(nullptr), ast(nullptr), tree(nullptr) {
+}
+
+
+bool Analyzer::analyze(bool syntax_only) {
+    bool result = syntax_only ? _analyze<true>() : _analyze<false>();
+    diagnostics->flush();
+    return result;
+}
+
+
+// Finds the first token of each declaration of the package, a const, var
+// or func outside braces, and the tokens inside the braces of the body of
+// each function.
+static void split_declarations(const TokenBuffer &tokens, std::vector<std::size_t> &starts,
+                               std::vector<std::pair<std::size_t, std::size_t>> &bodies) {
+    std::size_t depth = 0, body = 0;
+    bool in_function = false;
+    for (std::size_t i = 0; i + 1 < tokens.size(); ++i) {
+        Token token = tokens.get_token(i);
+        if (token == Token::O_BRACK) {
+            if (depth++ == 0 and in_function)
+                body = i + 1;
+        } else if (token == Token::C_BRACK) {
+            // Unbalanced ones are left to the parser.
+            if (depth > 0 and --depth == 0 and in_function) {
+                if (body < i)
+                    bodies.push_back({body, i});
+                in_function = false;
             }
+        } else if (depth == 0 and (token == Token::CONST or token == Token::VAR or token == Token::FUNC)) {
+            starts.push_back(i);
+            in_function = token == Token::FUNC;
         }
-        syntactic_table.push_back(row);
-        getline(syntactic_table_file, line);
     }
 }
 
 
-bool Analyzer::analyze() {
-    std::stack<ProductionItem> stack;
+template <bool SYNTAX_ONLY>
+bool Analyzer::_analyze(SyntaxSymbol start, std::size_t first) {
+    ParseStack stack;
     stack.push({SyntaxSymbol::NONE});
-    stack.push({SyntaxSymbol::PACKAGE});
+    stack.push({start});
+    statistics = {0, 0, 0};
+    operands.clear();
+    operators.clear();
+    recovering = false;
+    next_gap = 0;
+    gap_start = gaps.empty() ? SIZE_MAX : gaps.front().first;
+    tree = SYNTAX_ONLY ? nullptr : ast;
+    if (tree)
+        tree->clear();
 
-    LexicalDescriptor descriptor = lexical_analyzer->next();
-    bool found_errors = false;
+    // Wraps around to the first token on the first _advance.
+    token_index = first - 1;
+    found_errors = _advance();
     do {
-        if (stack.top().type == ProductionItem::SYMBOL) {
-            SyntaxSymbol curr_symbol{stack.top().value};
+        if (stack.top().type() == ProductionItem::SYMBOL) {
+            SyntaxSymbol curr_symbol{stack.top().value()};
 
-            bool need_next_token = false;
+            if (curr_symbol.is_terminal()) {
+                stack.pop();
+                if (curr_symbol == _lookahead()) {
+                    if (curr_symbol == Token::NONE)
+                        break;
 
-            try {
-                if (curr_symbol.is_terminal()) {
-                    if (curr_symbol == descriptor.get_token()) {
-                        stack.pop();
-
-                        if (curr_symbol != Token::NONE)
-                            context.get_attributes(curr_symbol, 0).line_no = descriptor.get_line_no();
-                        if (curr_symbol.variable_lexeme())
-                            context.set_lexeme(curr_symbol, descriptor.get_lexeme());
-
-                        need_next_token = true;
-
-                        if (descriptor.get_token() == Token::NONE)
-                            break;
-                    } else {
-                        stack.pop();
-                        throw SyntaxError(descriptor, curr_symbol);
-                    }
+                    if (not SYNTAX_ONLY)
+                        _shift(curr_symbol);
+                    recovering = false;
+                    if (_advance())
+                        found_errors = true;
                 } else {
-                    int production_id = _get_production(curr_symbol, descriptor);
-                    stack.pop();
-                    stack.push({production_id, ProductionItem::PRODUCTION_END});
-                    for (auto it = productions[production_id].rbegin();
-                            it != productions[production_id].rend(); ++it) {
-                        if (it->type == ProductionItem::SYMBOL)
-                            context.add_symbol(it->value);
-                        stack.push(*it);
-                    }
+                    _syntax_error(curr_symbol);
+                    if (_lookahead() == Token::NONE)
+                        break;
+                    // Goes on as if the terminal had been there; tokens
+                    // after the end of the package are left alone.
+                    if (not SYNTAX_ONLY and curr_symbol != Token::NONE)
+                        _insert(curr_symbol);
                 }
-
-            } catch (SyntaxError &err) {
-                std::cerr << err.what() << std::endl;
-                found_errors = true;
-
-                if (descriptor.get_token() == Token::NONE)
-                    break;
-
-                if (not err.get_expected()) {
-                    while (not stack.empty() and not _has_production(curr_symbol, descriptor)) {
-                        if (stack.top().type == ProductionItem::PRODUCTION_END)
-                            _clean_production(stack.top().value);
-                        stack.pop();
-                    }
+            } else if (curr_symbol == SyntaxSymbol::LV1EXPR) {
+                stack.pop();
+                if (not SYNTAX_ONLY) {
+                    _start_expression();
+                    stack.push({ProductionItem::EXPRESSION_END, ProductionItem::EXPRESSION});
                 }
-            }
-
-            if (need_next_token) {
-                while (true) {
-                    try {
-                        descriptor = lexical_analyzer->next();
-                        break;
-                    } catch (LexicalError &err) {
-                        std::cerr << err.what() << std::endl;
-                        found_errors = true;
-                    }
+                stack.push({ProductionItem::OPERAND, ProductionItem::EXPRESSION});
+            } else if (_has_production(curr_symbol)) {
+                int production_id = grammar::parse_table[curr_symbol - SyntaxSymbol::FIRST_NON_TERMINAL][_lookahead()];
+                ++statistics.expansions;
+                stack.pop();
+                if (tree and Ast::is_node(curr_symbol))
+                    open_nodes.push_back({tree->add_node(curr_symbol, _line_no()), stack.size()});
+                if (SYNTAX_ONLY) {
+                    int start = grammar::symbol_starts[production_id];
+                    stack.push(grammar::symbol_items.data() + start,
+                               grammar::symbol_starts[production_id + 1] - start);
+                } else {
+                    int start = grammar::slot_aliases.starts[production_id];
+                    stack.push(grammar::slot_aliases.items.data() + start,
+                               grammar::slot_aliases.starts[production_id + 1] - start);
+                    start = grammar::symbol_starts[production_id];
+                    context.add_symbols(grammar::expansion_symbols + start,
+                                        grammar::symbol_starts[production_id + 1] - start, curr_symbol,
+                                        grammar::slot_aliases.records.data() + start);
                 }
+            } else {
+                _syntax_error();
+                if (not _synchronize(curr_symbol))
+                    break;
+                // Ends the symbol empty unless it can start over.
+                if (not _has_production(curr_symbol))
+                    stack.pop();
             }
-        } else if (stack.top().type == ProductionItem::RULE) {
+        } else if (stack.top().type() == ProductionItem::RULE) {
+            ++statistics.rules;
+            _trace_rule(stack.top().value());
             try {
-                semantic_rules[stack.top().value](std::ref(context));
+                apply_rule(context, stack.top().value());
             } catch (SemanticError &err) {
-                std::cerr << err.what() << std::endl;
+                // Likely about attributes a syntax error left unset.
+                if (not recovering)
+                    diagnostics->report(err.get_diagnostic());
                 found_errors = true;
             }
             stack.pop();
+        } else if (stack.top().type() == ProductionItem::EXPRESSION) {
+            auto step = (ProductionItem::ExpressionStep)stack.top().value();
+            stack.pop();
+            if (not _expression_step<SYNTAX_ONLY>(stack, step))
+                break;
         } else /* ProductionItem::PRODUCTION_END */ {
-            if (stack.top().type == ProductionItem::PRODUCTION_END)
-                _clean_production(stack.top().value);
+            _clean_production(stack.top().value(), true);
             stack.pop();
+            if (not open_nodes.empty() and open_nodes.back().depth == stack.size())
+                _close_node();
         }
-    } while (not stack.empty());
+    } while (not stack.empty() and not diagnostics->full());
 
+    if (not stack.empty()) {
+        // The slots of the productions left unfinished.
+        context.clear();
+        operands.clear();
+        operators.clear();
+        // The tree keeps what was parsed, with its expressions left flat.
+        for (const OpenNode &open : open_nodes)
+            tree->close_node(open.node);
+        open_nodes.clear();
+        operand_starts.clear();
+        operand_nodes.clear();
+        expression_nodes.clear();
+    }
+    if (tree)
+        tree->set_types(context.get_types());
+    tree = nullptr;
     return not found_errors and stack.empty();
 }
 
 
-ProductionItem Analyzer::_parse_production_item(std::string item) {
-    if (item[0] >= '0' and item[0] <= '9') {
-        std::stringstream ss(item);
-        int value;
-        ss >> value;
-        return {value, ProductionItem::RULE};
-    } else {
-        SyntaxSymbol symbol(item);
-#ifdef DEBUG
-        assert(symbol != SyntaxSymbol::NONE);
-#endif
-        return {symbol, ProductionItem::SYMBOL};
+template <bool SYNTAX_ONLY>
+bool Analyzer::_expression_step(ParseStack &stack, ProductionItem::ExpressionStep step) {
+    if (step == ProductionItem::OPERAND) {
+        bool unary = _is_unary();
+        if (not SYNTAX_ONLY)
+            _start_operand(unary);
+        if (unary) {
+            stack.push({ProductionItem::AFTER_UNARY_TERM, ProductionItem::EXPRESSION});
+            if (not SYNTAX_ONLY)
+                stack.push({UNARY_OPERATION_RULE, ProductionItem::RULE});
+            stack.push({SyntaxSymbol::TERM});
+            stack.push({SyntaxSymbol::UNARYOPER});
+        } else {
+            stack.push({ProductionItem::AFTER_TERM, ProductionItem::EXPRESSION});
+            stack.push({SyntaxSymbol::TERM});
+        }
+        return true;
     }
+    if (step == ProductionItem::EXPRESSION_END) {
+        _end_expression();
+        return true;
+    }
+
+    if (not SYNTAX_ONLY)
+        _end_term(step == ProductionItem::AFTER_UNARY_TERM);
+    if (_rejecting_level() != SyntaxSymbol::NONE) {
+        // Panic mode on that LVnEXPRp, whose productions accept exactly
+        // the operators and whatever may follow the expression.
+        _syntax_error();
+        do {
+            if (_lookahead() == Token::NONE)
+                return false;
+            if (_advance())
+                found_errors = true;
+        } while (_rejecting_level() != SyntaxSymbol::NONE);
+    }
+    if (SYNTAX_ONLY) {
+        if (not binary_operators[_lookahead()].precedence)
+            return true;
+        if (_advance())
+            found_errors = true;
+    } else if (not _next_operator()) {
+        return true;
+    }
+    stack.push({ProductionItem::OPERAND, ProductionItem::EXPRESSION});
+    return true;
 }
 
 
-int Analyzer::_get_production(SyntaxSymbol symbol, LexicalDescriptor descriptor) {
-    auto &row = syntactic_table[symbol - SyntaxSymbol::FIRST_NON_TERMINAL];
-    auto it = row.find(descriptor.get_token());
-    if (it == row.end())
-        throw SyntaxError(descriptor);
-    return it->second;
+void Analyzer::_syntax_error(Token expected) {
+    if (not recovering)
+        diagnostics->report(SyntaxError(_descriptor(), expected).get_diagnostic());
+    found_errors = true;
+    recovering = true;
 }
 
 
-bool Analyzer::_has_production(SyntaxSymbol symbol, LexicalDescriptor descriptor) {
-    if (symbol.is_terminal())
-        return symbol == descriptor.get_token();
-    auto &row = syntactic_table[symbol - SyntaxSymbol::FIRST_NON_TERMINAL];
-    return row.find(descriptor.get_token()) != row.end();
+bool Analyzer::_synchronize(SyntaxSymbol symbol) {
+    const grammar::TokenSet &follow = grammar::follow_sets[symbol - SyntaxSymbol::FIRST_NON_TERMINAL];
+    while (not _has_production(symbol) and not follow.contains(_lookahead())) {
+        if (_lookahead() == Token::NONE)
+            return false;
+        if (_advance())
+            found_errors = true;
+    }
+    return true;
 }
 
 
-void Analyzer::_clean_production(int production_id) {
-    for (auto it = productions[production_id].rbegin(); it != productions[production_id].rend(); ++it)
-        if (it->type == ProductionItem::SYMBOL)
-            context.remove_symbol(it->value);
+bool Analyzer::analyze_parallel(unsigned num_threads) {
+    std::vector<std::size_t> starts;
+    std::vector<std::pair<std::size_t, std::size_t>> bodies;
+    if (token_buffer)
+        split_declarations(*token_buffer, starts, bodies);
+    if (num_threads < 2 or starts.size() < 2)
+        return analyze();
+
+    // The globals as the declarations leave them, which the bodies of the
+    // functions do not change.
+    // Any error sends the package to a single thread, so one is enough.
+    Diagnostics discarded(nullptr, Diagnostics::Format::TEXT, 1);
+    Analyzer headers(token_buffer);
+    headers.diagnostics = &discarded;
+    headers.gaps = std::move(bodies);
+    if (not headers.analyze())
+        return analyze();
+    SymbolTable &globals = headers.context.get_symbol_table();
+
+    // Runs of declarations of about the same number of tokens; the first
+    // one takes the package clause and imports along.
+    std::vector<std::size_t> firsts{0};
+    std::size_t run_size = token_buffer->size() / num_threads;
+    for (std::size_t i = 1; i < starts.size() and firsts.size() < num_threads; ++i)
+        if (starts[i] >= run_size * firsts.size())
+            firsts.push_back(i);
+
+    std::vector<std::unique_ptr<Analyzer>> runs;
+    std::vector<Diagnostics> outputs(firsts.size(),
+                                     Diagnostics(nullptr, Diagnostics::Format::TEXT, diagnostics->get_max_errors()));
+    SymbolTable declared;
+    for (std::size_t run = 0; run < firsts.size(); ++run) {
+        runs.emplace_back(new Analyzer(token_buffer));
+        Analyzer &analyzer = *runs.back();
+        analyzer.diagnostics = &outputs[run];
+        std::size_t last = run + 1 < firsts.size() ? firsts[run + 1] : starts.size();
+        if (last < starts.size())
+            analyzer.gaps.push_back({starts[last], token_buffer->size() - 1});
+        analyzer.context.get_symbol_table() = declared;
+        // The types of the records of declared are ids in the table of the
+        // first pass.
+        analyzer.context.get_types() = headers.context.get_types();
+        // The names the declarations of the run declare, for the next ones.
+        for (std::size_t i = firsts[run]; i < last; ++i) {
+            if (token_buffer->get_token(starts[i] + 1) != Token::IDENT)
+                continue;
+            std::uint32_t id = token_buffer->get_identifier(starts[i] + 1);
+            if (globals.has_symbol(id) and declared.add_symbol(id))
+                declared.get_record(id) = globals.get_record(id);
+        }
+    }
+
+    std::vector<char> results(runs.size());
+    std::vector<std::thread> workers;
+    for (std::size_t run = 1; run < runs.size(); ++run)
+        workers.emplace_back([&runs, &results, &starts, &firsts, run] {
+            results[run] = runs[run]->_analyze<false>(SyntaxSymbol::PKG_DECLS, starts[firsts[run]]);
+        });
+    results[0] = runs[0]->_analyze<false>();
+    for (auto &worker : workers)
+        worker.join();
+
+    statistics = {0, 0, 0};
+    bool result = true;
+    for (std::size_t run = 0; run < runs.size(); ++run) {
+        diagnostics->take(outputs[run]);
+        const Statistics &run_statistics = runs[run]->statistics;
+        statistics.expansions += run_statistics.expansions;
+        statistics.rules += run_statistics.rules;
+        statistics.expressions += run_statistics.expressions;
+        result = result and results[run];
+    }
+    diagnostics->flush();
+    return result;
 }
 
 
-SyntaxError::SyntaxError(const LexicalDescriptor &lex, Token expected) :
-        descriptor(lex), expected(expected) {
-    std::stringstream ss;
-    ss << "Unexpected token " << lex.get_token() <<
-            " <" << lex.get_lexeme() << "> at line " << lex.get_line_no() << ".";
-    if (expected != Token::NONE) {
-        ss << " Expected token " << expected << ".";
+bool Analyzer::analyze_descent() {
+    tree = nullptr;
+    statistics = {0, 0, 0};
+    operands.clear();
+    operators.clear();
+    token_index = -1;
+    found_errors = _advance();
+    bool finished = false;
+    try {
+        _descend_PACKAGE();
+        if (_lookahead() != Token::NONE)
+            throw SyntaxError(_descriptor(), Token::NONE);
+        finished = true;
+    } catch (SyntaxError &err) {
+        diagnostics->report(err.get_diagnostic());
+    } catch (ErrorLimit &) {
     }
-    msg = ss.str();
+    diagnostics->flush();
+    if (not finished) {
+        // The slots of the productions left unfinished.
+        context.clear();
+        tail_productions.clear();
+        operands.clear();
+        operators.clear();
+        return false;
+    }
+    return not found_errors;
+}
+
+
+bool Analyzer::_advance() {
+    bool malformed = false;
+    while (true) {
+        if (token_buffer) {
+            if (++token_index == gap_start)
+                _skip_gap();
+        } else if (pipelined_lexer) {
+            descriptor = pipelined_lexer->next();
+        } else {
+            descriptor = lexical_analyzer->next();
+        }
+        if (_lookahead() != Token::ERROR)
+            return malformed;
+        diagnostics->report(LexicalError(_descriptor()).get_diagnostic());
+        malformed = true;
+    }
+}
+
+
+void Analyzer::_clean_production(int production_id, bool aliased) {
+    int start = grammar::symbol_starts[production_id];
+    context.remove_symbols(grammar::expansion_symbols + start, grammar::symbol_starts[production_id + 1] - start,
+                           aliased ? grammar::slot_aliases.records.data() + start : nullptr);
+}
+
+
+void Analyzer::_close_node() {
+    std::uint32_t node = open_nodes.back().node;
+    open_nodes.pop_back();
+    tree->close_node(node);
+    AstNode &closed = (*tree)[node];
+    if (closed.kind != SyntaxSymbol::PACKAGE)
+        closed.type = context.get_attributes(closed.kind).type_dim;
+    // A term of a single literal, identifier or parenthesized expression
+    // is that child.
+    if (closed.kind == SyntaxSymbol::TERM and closed.size > 1 and (*tree)[node + 1].size == closed.size - 1)
+        tree->collapse_node(node);
+}
+
+
+void Analyzer::_descend_LV1EXPR() {
+    _start_expression();
+    bool unary;
+    do {
+        unary = _is_unary();
+        _start_operand(unary);
+        if (unary) {
+            _descend_UNARYOPER();
+            _descend_TERM();
+            _apply_rule(UNARY_OPERATION_RULE);
+        } else {
+            _descend_TERM();
+        }
+        _end_term(unary);
+        if (_rejecting_level() != SyntaxSymbol::NONE)
+            throw SyntaxError(_descriptor());
+    } while (_next_operator());
+    _end_expression();
+}
+
+
+void Analyzer::_start_expression() {
+    ++statistics.expressions;
+    operators.push_back({0, Operation::NONE, 0, operands.size(), Token::NONE});
+}
+
+
+void Analyzer::_start_operand(bool unary) {
+    // In place of LV5EXPR -> UNARYOPER TERM 88 ... or LV5EXPR -> TERM ...
+    ++statistics.expansions;
+    context.add_symbol(SyntaxSymbol::TERM);
+    if (unary)
+        context.add_symbol(SyntaxSymbol::UNARYOPER);
+    if (tree)
+        operand_starts.push_back((std::uint32_t)tree->size());
+}
+
+
+void Analyzer::_end_term(bool unary) {
+    operands.push_back(std::move(context.get_attributes(SyntaxSymbol::TERM)));
+    context.remove_symbol(SyntaxSymbol::TERM);
+    if (unary)
+        context.remove_symbol(SyntaxSymbol::UNARYOPER);
+    if (not tree)
+        return;
+
+    std::uint32_t start = operand_starts.back();
+    operand_starts.pop_back();
+    // Stands for a term that was missing.
+    if (tree->size() == start)
+        tree->add_node(Token::ERROR, _line_no());
+    AstNode &head = (*tree)[start];
+    if (unary and head.size == 1 and tree->size() > start + 1) {
+        // The operator takes the term as its child.
+        tree->close_node(start);
+        head.type = operands.back().type_dim;
+    }
+    operand_nodes.push_back((int)expression_nodes.size());
+    expression_nodes.push_back({start, (std::uint32_t)(tree->size() - start), head.line_no, Token::NONE, -1, -1,
+                                head.type});
+}
+
+
+SyntaxSymbol Analyzer::_rejecting_level() const {
+    // The productions go down from LV5EXPRp to the level of the operator,
+    // or to LV1EXPRp, expanding each with the same lookahead.
+    for (int level = 5; level >= std::max(binary_operators[_lookahead()].precedence, 1); --level) {
+        SyntaxSymbol rest{SyntaxSymbol::LV1EXPRp + 3 * (level - 1)};
+        if (not _has_production(rest))
+            return rest;
+    }
+    return SyntaxSymbol::NONE;
 }
 
 
+bool Analyzer::_next_operator() {
+    const BinaryOperator &binary = binary_operators[_lookahead()];
+    _reduce(binary.precedence);
+    if (not binary.precedence)
+        return false;
+    operators.push_back({binary.precedence, binary.operation, _line_no(), 0, _lookahead()});
+    if (_advance())
+        found_errors = true;
+    return true;
+}
+
+
+void Analyzer::_reduce(int precedence) {
+    // Operators of equal precedence associate to the left; the sentinel
+    // opening the expression stops it.
+    while (operators.back().precedence >= std::max(precedence, 1)) {
+        SymbolAttributes right = std::move(operands.back());
+        operands.pop_back();
+        // The left operand carries the operation and its line, as the
+        // LVnEXPR slot does in the productions.
+        SymbolAttributes &left = operands.back();
+        left.operation = operators.back().operation;
+        left.line_no = operators.back().line_no;
+        ++statistics.rules;
+        _trace_rule(NUM_OF_SEMANTIC_RULES + (int)left.operation);
+        try {
+            apply_operation(context, left, right);
+        } catch (SemanticError &err) {
+            if (not recovering)
+                diagnostics->report(err.get_diagnostic());
+            found_errors = true;
+        }
+        left = std::move(right);
+
+        if (tree) {
+            int right_node = operand_nodes.back();
+            operand_nodes.pop_back();
+            int left_node = operand_nodes.back();
+            operand_nodes.back() = (int)expression_nodes.size();
+            expression_nodes.push_back({expression_nodes[left_node].start,
+                                        1 + expression_nodes[left_node].size + expression_nodes[right_node].size,
+                                        (std::uint32_t)operators.back().line_no, operators.back().token,
+                                        left_node, right_node, left.type_dim});
+        }
+        operators.pop_back();
+    }
+}
+
+
+void Analyzer::_end_expression() {
+#ifdef DEBUG
+    assert(operators.back().precedence == 0);
+    assert(operands.size() == operators.back().operand_base + 1);
+#endif
+    context.get_attributes(SyntaxSymbol::LV1EXPR) = std::move(operands.back());
+    operands.pop_back();
+    operators.pop_back();
+    if (tree)
+        _emit_expression();
+}
+
+
+void Analyzer::_emit_expression() {
+    int root = operand_nodes.back();
+    operand_nodes.pop_back();
+    // Nodes of nested expressions were emitted and dropped already, so the
+    // expression's are the last ones, and its first operand the first.
+    int first = root;
+    while (expression_nodes[first].left >= 0)
+        first = expression_nodes[first].left;
+    if (root != first) {
+        emitted.clear();
+        emit_stack.push_back(root);
+        while (not emit_stack.empty()) {
+            const ExpressionNode &expression_node = expression_nodes[emit_stack.back()];
+            emit_stack.pop_back();
+            if (expression_node.left < 0) {
+                emitted.insert(emitted.end(), &(*tree)[expression_node.start],
+                               &(*tree)[expression_node.start] + expression_node.size);
+            } else {
+                emitted.push_back({(std::uint16_t)expression_node.token, expression_node.type, expression_node.size,
+                                   expression_node.line_no, 0});
+                emit_stack.push_back(expression_node.right);
+                emit_stack.push_back(expression_node.left);
+            }
+        }
+        tree->replace_tail(expression_nodes[first].start, emitted.data(), emitted.size());
+    }
+    expression_nodes.resize(first);
+}
+
+
+SyntaxError::SyntaxError(const LexicalDescriptor &lex, Token expected) :
+        diagnostic{DiagnosticCode::UNEXPECTED_TOKEN, (std::uint16_t)lex.get_token(), (std::uint16_t)expected,
+                   (std::uint32_t)lex.get_line_no(), lex.get_lexeme()} { }
+
+
 SyntaxError::~SyntaxError() { }
+
+
+const char *SyntaxError::what() const throw() {
+    if (msg.empty()) {
+        std::stringstream ss;
+        ss << *this;
+        msg = ss.str();
+    }
+    return msg.c_str();
+}
+
+
+std::ostream &operator<<(std::ostream &out, const SyntaxError &err) {
+    return out << err.get_diagnostic();
+}
@@ -1,70 +1,343 @@
 #ifndef ALGO_ANALYZER_H
 #define ALGO_ANALYZER_H
 
-#include <fstream>
 #include <iostream>
-#include <stack>
 
+#include "ast.h"
+#include "diagnostics.h"
+#include "grammar.h"
 #include "lexical_analyzer.h"
+#include "parse_stack.h"
+#include "pipelined_lexer.h"
 #include "semantic_rules.h"
+#include "token_buffer.h"
 
 
-struct ProductionItem {
-    int value;
-    enum Type {
-        SYMBOL,
-        RULE,
-        PRODUCTION_END
-    } type;
+class SyntaxError : public std::exception {
+public:
+    SyntaxError(const LexicalDescriptor &lex, Token expected = Token::NONE);
+
+    virtual ~SyntaxError();
 
-    ProductionItem(int value, Type type=SYMBOL) : value(value), type(type) {}
+    // Formatted on first use.
+    virtual const char *what() const throw();
+
+    const Diagnostic &get_diagnostic() const {
+        return diagnostic;
+    }
+
+private:
+    Diagnostic diagnostic;
+    mutable std::string msg;
 };
 
+
+std::ostream &operator<<(std::ostream &out, const SyntaxError &err);
+
+
 class Analyzer {
 public:
     Analyzer(LexicalAnalyzer *lexical_analyzer);
 
-    bool analyze();
+    // Consumes the tokens by index instead of lexing while parsing.
+    Analyzer(TokenBuffer *token_buffer);
+
+    // Consumes the tokens of a lexer running on another thread.
+    Analyzer(PipelinedLexer *pipelined_lexer);
+
+    // With syntax_only, recognizes the input without running the semantic
+    // rules or keeping any attributes, so only syntax errors are found.
+    bool analyze(bool syntax_only = false);
+
+    // Makes the next full analyze build its tree into ast, which is
+    // cleared first; nullptr stops it. Neither syntax-only analysis nor
+    // analyze_descent build one.
+    void build_ast(Ast *ast) {
+        this->ast = ast;
+    }
+
+    // Parses the declarations of the package in runs of about equal size,
+    // each on its own thread with its own parse stack and context, and
+    // reports what they found in source order. The globals each run
+    // starts with come from a first pass over the declarations with the
+    // bodies of the functions skipped; when that pass finds any error,
+    // the package is analyzed on a single thread instead. Needs the
+    // tokens buffered, and builds no tree.
+    bool analyze_parallel(unsigned num_threads);
+
+    // Where the diagnostics of the analyses go, instead of standard error.
+    // Each analysis stops early once diagnostics is full, and flushes it.
+    void report_to(Diagnostics *diagnostics) {
+        this->diagnostics = diagnostics;
+    }
+
+    // Parses with the recursive-descent functions generated from the same
+    // grammar, firing the same rules in the same order as analyze. Stops at
+    // the first syntax error instead of recovering.
+    bool analyze_descent();
+
+    // Makes later analyses append the semantic rules they run, in order,
+    // to rules; nullptr stops it. An operation reduced in an expression
+    // counts as rule NUM_OF_SEMANTIC_RULES + the Operation. analyze leaves
+    // out the copy rules slot_aliases elided, and analyze_parallel traces
+    // only when it falls back to a single thread. Only meant for checking
+    // the two engines against each other.
+    void trace_rules(std::vector<int> *rules) {
+        rule_trace = rules;
+    }
+
+    // Work done by the last analysis.
+    struct Statistics {
+        std::size_t expansions;
+        std::size_t rules;
+        std::size_t expressions;
+    };
+
+    const Statistics &get_statistics() const {
+        return statistics;
+    }
 
 private:
-    ProductionItem _parse_production_item(std::string item);
-    int _get_production(SyntaxSymbol symbol, LexicalDescriptor descriptor);
-    bool _has_production(SyntaxSymbol symbol, LexicalDescriptor descriptor);
-    void _clean_production(int production_id);
+    // Parses from the token at first, which is where start begins.
+    template <bool SYNTAX_ONLY>
+    bool _analyze(SyntaxSymbol start = SyntaxSymbol::PACKAGE, std::size_t first = 0);
 
-    LexicalAnalyzer *lexical_analyzer;
-    std::vector<std::vector<ProductionItem>> productions;
-    std::vector<std::map<Token, int>> syntactic_table;
-    RuleContext context;
-};
+    // Moves to the next token, reporting the malformed lexemes on the way.
+    bool _advance();
 
+    // Jumps over the tokens of the next gap.
+    void _skip_gap() {
+        token_index = gaps[next_gap].second;
+        ++next_gap;
+        gap_start = next_gap < gaps.size() ? gaps[next_gap].first : SIZE_MAX;
+    }
 
-class SyntaxError : public std::exception {
-public:
-    SyntaxError(const LexicalDescriptor &lex, Token expected = Token::NONE);
+    Token _lookahead() const {
+        return token_buffer ? token_buffer->get_token(token_index) : descriptor.get_token();
+    }
 
-    virtual ~SyntaxError();
+    LexicalDescriptor _descriptor() const {
+        return token_buffer ? token_buffer->get_descriptor(token_index) : descriptor;
+    }
 
-    virtual const char *what() const throw() {
-        return msg.c_str();
+    std::size_t _line_no() const {
+        return token_buffer ? token_buffer->get_line_no(token_index) : descriptor.get_line_no();
     }
 
-    const std::string &get_lexeme() const {
-        return descriptor.get_lexeme();
+    // Sets the attributes of a matched terminal.
+    void _shift(SyntaxSymbol symbol) {
+        LexicalDescriptor matched = _descriptor();
+        context.get_attributes(symbol, 0).line_no = matched.get_line_no();
+        if (symbol == Token::IDENT)
+            context.set_identifier(matched.get_identifier());
+        else if (symbol.is_literal())
+            context.set_literal(symbol, matched.get_literal());
+        if (tree and Ast::is_node(symbol))
+            _add_leaf(symbol, matched.get_line_no(), matched.get_identifier(), matched.get_literal());
     }
 
-    std::size_t get_line_no() const {
-        return descriptor.get_line_no();
+    // Sets the attributes of a terminal that error recovery takes as there.
+    void _insert(SyntaxSymbol symbol) {
+        context.get_attributes(symbol, 0).line_no = _line_no();
+        if (symbol == Token::IDENT)
+            context.set_identifier(Interner::EMPTY_NAME);
+        else if (symbol.is_literal())
+            context.set_literal(symbol, LiteralValue());
+        if (tree and Ast::is_node(symbol))
+            _add_leaf(symbol, _line_no(), Interner::EMPTY_NAME, LiteralValue());
     }
 
-    SyntaxSymbol get_expected() const {
-        return expected;
+    void _add_leaf(SyntaxSymbol symbol, std::size_t line_no, std::uint32_t identifier,
+                   const LiteralValue &literal) {
+        if (symbol == Token::IDENT)
+            tree->add_node(symbol, line_no, identifier);
+        else if (symbol.is_literal())
+            tree->add_node(symbol, line_no, tree->add_literal(literal));
+        else
+            tree->add_node(symbol, line_no);
     }
 
-private:
+    // Gives the node of the production that ends the types its rules left
+    // in the symbol's slot.
+    void _close_node();
+
+    bool _has_production(SyntaxSymbol symbol) const {
+        if (symbol.is_terminal())
+            return symbol == _lookahead();
+        return grammar::parse_table[symbol - SyntaxSymbol::FIRST_NON_TERMINAL][_lookahead()] !=
+                grammar::NO_PRODUCTION;
+    }
+    // The table-driven loop expands productions with their copy rules
+    // elided, so their slots are aliased.
+    void _clean_production(int production_id, bool aliased = false);
+
+    // Error recovery of the table-driven loop, which throws nothing. An
+    // error is reported unless no token was matched since the previous one,
+    // which is then most likely a consequence of it; semantic errors are
+    // held back the same way.
+    void _syntax_error(Token expected = Token::NONE);
+
+    // Panic mode: skips tokens up to one that symbol expands with or that
+    // may follow it, in FOLLOW(symbol). Returns false if the input ends
+    // first. Each token is skipped once and each stack item popped once,
+    // so recovery as a whole is linear in the input.
+    bool _synchronize(SyntaxSymbol symbol);
+
+    // Expressions are parsed by precedence climbing instead of through the
+    // LV1EXPR to LV5EXPR productions, which take a dozen expansions and as
+    // many copy rules per operand. Operands still go through UNARYOPER and
+    // TERM, and the attributes come out as the productions left them.
+    void _start_expression();
+
+    bool _is_unary() const {
+        return grammar::parse_table[SyntaxSymbol::UNARYOPER - SyntaxSymbol::FIRST_NON_TERMINAL][_lookahead()] !=
+                grammar::NO_PRODUCTION;
+    }
+
+    void _start_operand(bool unary);
+
+    // Moves the operand out of the TERM slot.
+    void _end_term(bool unary);
+
+    // The first LVnEXPRp the productions would have found no production
+    // for with the token after an operand, or NONE.
+    SyntaxSymbol _rejecting_level() const;
+
+    // Reduces what the operator after the operand allows; returns whether
+    // there is such an operator, which is then consumed.
+    bool _next_operator();
+
+    void _reduce(int precedence);
+
+    void _end_expression();
+
+    // Rewrites the operands of the expression, which lie side by side in
+    // the tree, in preorder under its operators.
+    void _emit_expression();
+
+    // Returns false when the input ended during recovery.
+    template <bool SYNTAX_ONLY>
+    bool _expression_step(ParseStack &stack, ProductionItem::ExpressionStep step);
+
+    // The recursive-descent engine, one _descend_ function per non-terminal.
+#include "descent_parser.h"
+
+    void _descend_LV1EXPR();
+
+    // Unwinds the recursive-descent engine once diagnostics is full.
+    struct ErrorLimit { };
+
+    void _match(Token token) {
+        if (_lookahead() != token)
+            throw SyntaxError(_descriptor(), token);
+        _shift(SyntaxSymbol(token));
+        if (_advance())
+            found_errors = true;
+        if (diagnostics->full())
+            throw ErrorLimit();
+    }
+
+    void _trace_rule(int rule) {
+        if (rule_trace)
+            rule_trace->push_back(rule);
+    }
+
+    void _apply_rule(int rule) {
+        ++statistics.rules;
+        _trace_rule(rule);
+        try {
+            apply_rule(context, rule);
+        } catch (SemanticError &err) {
+            diagnostics->report(err.get_diagnostic());
+            found_errors = true;
+            if (diagnostics->full())
+                throw ErrorLimit();
+        }
+    }
+
+    void _expand(int production_id) {
+        ++statistics.expansions;
+        int start = grammar::symbol_starts[production_id];
+        context.add_symbols(grammar::expansion_symbols + start, grammar::symbol_starts[production_id + 1] - start);
+    }
+
+    void _finish(int production_id) {
+        _clean_production(production_id);
+    }
+
+    // Finishes the productions a _descend_ function looped over instead of
+    // recursing, innermost first.
+    void _finish_tail(std::size_t base) {
+        while (tail_productions.size() > base) {
+            _clean_production(tail_productions.back());
+            tail_productions.pop_back();
+        }
+    }
+
+    LexicalAnalyzer *lexical_analyzer;
+    TokenBuffer *token_buffer;
+    PipelinedLexer *pipelined_lexer;
+    std::size_t token_index;
     LexicalDescriptor descriptor;
-    SyntaxSymbol expected;
-    std::string msg;
+    // Ranges of buffered tokens, in order, that are not parsed: on reaching
+    // the first of a range the parser goes on from its end.
+    std::vector<std::pair<std::size_t, std::size_t>> gaps;
+    std::size_t next_gap;
+    std::size_t gap_start;
+    Diagnostics standard_error;
+    Diagnostics *diagnostics;
+    RuleContext context;
+    bool found_errors;
+    bool recovering;
+    std::vector<int> tail_productions;
+    Statistics statistics;
+    std::vector<int> *rule_trace;
+
+    struct PendingOperator {
+        int precedence;
+        Operation operation;
+        std::size_t line_no;
+        // Operands below the expression, for the sentinel of precedence 0
+        // that opens each one.
+        std::size_t operand_base;
+        Token token;
+    };
+
+    std::vector<SymbolAttributes> operands;
+    std::vector<PendingOperator> operators;
+
+    // The tree asked for, and the one being built by the current analysis.
+    Ast *ast;
+    Ast *tree;
+
+    struct OpenNode {
+        std::uint32_t node;
+        // Size of the parse stack under the production of the node.
+        std::size_t depth;
+    };
+
+    std::vector<OpenNode> open_nodes;
+
+    // An operand of an expression, with its nodes in the tree, or an
+    // operator over two earlier ones.
+    struct ExpressionNode {
+        std::uint32_t start;
+        // Nodes of the subtree.
+        std::uint32_t size;
+        std::uint32_t line_no;
+        Token token;
+        int left;
+        int right;
+        TypeId type;
+    };
+
+    // Where each operand of operand_nodes starts in the tree, until it ends.
+    std::vector<std::uint32_t> operand_starts;
+    // Parallel to operands.
+    std::vector<int> operand_nodes;
+    std::vector<ExpressionNode> expression_nodes;
+    std::vector<int> emit_stack;
+    std::vector<AstNode> emitted;
 };
 
 #endif //ALGO_ANALYZER_H
@@ -0,0 +1,28 @@
+#include <cstring>
+
+#include "ast.h"
+
+
+void Ast::replace_tail(std::size_t first, const AstNode *replacement, std::size_t size) {
+    if (first + size > capacity)
+        _grow(first + size);
+    std::memcpy(&nodes[first], replacement, size * sizeof(AstNode));
+    count = first + size;
+}
+
+
+void Ast::collapse_node(std::uint32_t node) {
+    AstNode &child = nodes[node + 1];
+    child.type = nodes[node].type;
+    std::memmove(&nodes[node], &child, (count - node - 1) * sizeof(AstNode));
+    --count;
+}
+
+
+void Ast::_grow(std::size_t needed) {
+    while (capacity < needed)
+        capacity *= 2;
+    std::unique_ptr<AstNode[]> grown(new AstNode[capacity]);
+    std::memcpy(grown.get(), nodes.get(), count * sizeof(AstNode));
+    nodes = std::move(grown);
+}
@@ -0,0 +1,156 @@
+#ifndef ALGO_AST_H
+#define ALGO_AST_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "grammar.h"
+#include "literal.h"
+#include "type_table.h"
+
+
+// Node of the abstract syntax tree. Children follow their parent, so the
+// first child of node i is i + 1 and its next sibling is i + size.
+struct AstNode {
+    // The grammar symbol of the construct, or the token of a leaf.
+    // Operator tokens head their operands.
+    std::uint16_t kind;
+    // Type of the construct as the semantic rules left it, in the types of
+    // the tree.
+    TypeId type;
+    // Nodes in the subtree, this one included.
+    std::uint32_t size;
+    std::uint32_t line_no;
+    // Interned name of an IDENT, index of the literal of a literal token.
+    std::uint32_t value;
+};
+
+static_assert(sizeof(AstNode) == 20, "AstNode is meant to stay small");
+
+
+static constexpr int NUM_OF_AST_KINDS = SyntaxSymbol::PACKAGE + grammar::NUM_OF_NON_TERMINALS;
+
+
+// The symbols with a node of their own.
+static constexpr std::array<bool, NUM_OF_AST_KINDS> make_ast_node_symbols() {
+    std::array<bool, NUM_OF_AST_KINDS> symbols{};
+    for (int token = Token::IDENT; token <= Token::FALSE; ++token)
+        symbols[token] = true;
+    for (int token = Token::A_PLUS; token <= Token::ASSIGN; ++token)
+        symbols[token] = true;
+    for (int token = Token::BOOL; token <= Token::STR; ++token)
+        symbols[token] = true;
+    // The unary operators; the binary ones are added by the expression
+    // parser, above their operands.
+    for (int token : {Token::PLUS, Token::MINUS, Token::BW_XOR_NEG, Token::NOT})
+        symbols[token] = true;
+    symbols[Token::BREAK] = true;
+    symbols[Token::CONTINUE] = true;
+    for (int symbol : {SyntaxSymbol::PACKAGE, SyntaxSymbol::CONST_DECL, SyntaxSymbol::VAR_DECL,
+                       SyntaxSymbol::FUNC_DECL, SyntaxSymbol::PARAM_LIST, SyntaxSymbol::TYPEp,
+                       SyntaxSymbol::BLOCK, SyntaxSymbol::EXPR, SyntaxSymbol::RETURNp,
+                       SyntaxSymbol::IF_CONST, SyntaxSymbol::FOR_CONST, SyntaxSymbol::TERM,
+                       SyntaxSymbol::FUNC_CALL, SyntaxSymbol::ARRAY_ACC, SyntaxSymbol::CAST,
+                       SyntaxSymbol::ARR_LIT})
+        symbols[symbol] = true;
+    return symbols;
+}
+
+static constexpr auto ast_node_symbols = make_ast_node_symbols();
+
+
+// Abstract syntax tree of a file, built by Analyzer::analyze. The nodes
+// are in preorder in a single block, which clear keeps for the next file,
+// so the tree is freed in O(1) and rebuilt without allocating.
+//
+// Symbols that only shape the grammar, like the primed ones, the lists and
+// LV1EXPR to LV5EXPR, have no node; their children go to the nearest one
+// that does. Punctuation and keywords implied by their parent are dropped.
+class Ast {
+public:
+    explicit Ast(std::size_t capacity = 4096) : nodes(new AstNode[capacity]), count(0), capacity(capacity) { }
+
+    Ast(const Ast &) = delete;
+
+    Ast &operator=(const Ast &) = delete;
+
+    virtual ~Ast() { }
+
+    static bool is_node(SyntaxSymbol symbol) {
+        return ast_node_symbols[symbol];
+    }
+
+    void clear() {
+        count = 0;
+        literals.clear();
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    // Nodes the block holds before it has to grow.
+    std::size_t get_capacity() const {
+        return capacity;
+    }
+
+    const AstNode &operator[](std::size_t index) const {
+        return nodes[index];
+    }
+
+    AstNode &operator[](std::size_t index) {
+        return nodes[index];
+    }
+
+    const LiteralValue &get_literal(std::uint32_t index) const {
+        return literals[index];
+    }
+
+    // What the types of the nodes are ids in.
+    const TypeTable &get_types() const {
+        return types;
+    }
+
+    // Takes a copy of the types of the analysis that built the tree.
+    void set_types(const TypeTable &types) {
+        this->types = types;
+    }
+
+    // Appends a leaf; it becomes a parent by growing its size.
+    std::uint32_t add_node(SyntaxSymbol kind, std::size_t line_no, std::uint32_t value = 0) {
+        if (count == capacity)
+            _grow(count + 1);
+        nodes[count] = {(std::uint16_t)kind, 0, 1, (std::uint32_t)line_no, value};
+        return (std::uint32_t)count++;
+    }
+
+    std::uint32_t add_literal(const LiteralValue &literal) {
+        literals.push_back(literal);
+        return (std::uint32_t)(literals.size() - 1);
+    }
+
+    // Makes node the parent of every node added after it.
+    void close_node(std::uint32_t node) {
+        nodes[node].size = (std::uint32_t)(count - node);
+    }
+
+    // Replaces the nodes from first on by replacement[0] up to replacement[size].
+    void replace_tail(std::size_t first, const AstNode *replacement, std::size_t size);
+
+    // Removes node, which must be the last one with children and have a
+    // single child, leaving the child in its place with the node's type.
+    void collapse_node(std::uint32_t node);
+
+private:
+    void _grow(std::size_t needed);
+
+    std::unique_ptr<AstNode[]> nodes;
+    std::size_t count;
+    std::size_t capacity;
+    std::vector<LiteralValue> literals;
+    TypeTable types;
+};
+
+#endif //ALGO_AST_H
@@ -0,0 +1,128 @@
+// Times the full analysis of a file with and without building its tree,
+// then passes over the tree, which reuse it instead of parsing again.
+//
+//   ast_benchmark <file> [repetitions]
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "analyzer.h"
+#include "command_line.h"
+
+
+using namespace std;
+
+
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+
+// Walks the tree by the sizes of the nodes, as a pass that needs the
+// nesting does. Returns the greatest depth, or 0 if the children of some
+// node do not add up to its size.
+static size_t depth_pass(const Ast &ast) {
+    // The ends of the open nodes.
+    vector<size_t> ends;
+    size_t depth = 0;
+    for (size_t i = 0; i < ast.size(); ++i) {
+        while (not ends.empty() and ends.back() == i)
+            ends.pop_back();
+        if (not ends.empty() and i + ast[i].size > ends.back())
+            return 0;
+        ends.push_back(i + ast[i].size);
+        depth = max(depth, ends.size());
+    }
+    return ends.empty() or ends.front() == ast.size() ? depth : 0;
+}
+
+
+// Counts the uses of each name, as a pass that only looks at leaves does.
+static size_t identifier_pass(const Ast &ast, vector<size_t> &uses) {
+    size_t identifiers = 0;
+    for (size_t i = 0; i < ast.size(); ++i) {
+        if (ast[i].kind != Token::IDENT)
+            continue;
+        if (ast[i].value >= uses.size())
+            uses.resize(ast[i].value + 1);
+        ++uses[ast[i].value];
+        ++identifiers;
+    }
+    return identifiers;
+}
+
+
+static bool build(TokenBuffer &tokens, Ast &ast) {
+    Analyzer analyzer(&tokens);
+    analyzer.build_ast(&ast);
+    return analyzer.analyze();
+}
+
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <file> [repetitions]" << endl;
+        return 1;
+    }
+    int repetitions = parse_repetitions(argc, argv, 2, 5);
+    if (repetitions == 0)
+        return 1;
+
+    SourceCode source_code(argv[1]);
+    TokenBuffer tokens(&source_code);
+    // The diagnostics are not what is being timed.
+    cerr.rdbuf(nullptr);
+
+    Analyzer(&tokens).analyze();
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        Analyzer(&tokens).analyze();
+    double plain_ms = elapsed_ms(start) / repetitions;
+
+    // Every build makes its own analyzer, so the two differ only in where
+    // the nodes go: a new tree, which grows its block as it fills, or the
+    // one the previous build left. The runs alternate so that both see the
+    // same state of the machine. Both timings leave out a first run, which
+    // also pays for faulting the memory in.
+    Ast ast;
+    bool result = build(tokens, ast);
+    size_t capacity = ast.get_capacity();
+    double fresh_ms = 0, reused_ms = 0;
+    for (int i = 0; i < repetitions; ++i) {
+        start = chrono::steady_clock::now();
+        Ast fresh;
+        build(tokens, fresh);
+        fresh_ms += elapsed_ms(start);
+        start = chrono::steady_clock::now();
+        build(tokens, ast);
+        reused_ms += elapsed_ms(start);
+    }
+    fresh_ms /= repetitions;
+    reused_ms /= repetitions;
+
+    size_t depth = 0, identifiers = 0;
+    vector<size_t> uses;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        depth = depth_pass(ast);
+    double depth_ms = elapsed_ms(start) / repetitions;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        identifiers = identifier_pass(ast, uses);
+    double identifier_ms = elapsed_ms(start) / repetitions;
+
+    cout << tokens.size() << " tokens, " << ast.size() << " nodes, " << ast.size() * sizeof(AstNode) <<
+            " bytes" << (result ? "" : ", rejected") << endl;
+    cout << "analysis           " << plain_ms << " ms" << endl;
+    cout << "with tree, fresh   " << fresh_ms << " ms" << endl;
+    cout << "with tree, reused  " << reused_ms << " ms, " <<
+            (ast.get_capacity() == capacity ? "no growth" : "grew") << endl;
+    if (depth)
+        cout << "depth pass         " << depth_ms << " ms, depth " << depth << endl;
+    else
+        cout << "depth pass         " << depth_ms << " ms, malformed tree" << endl;
+    cout << "identifier pass    " << identifier_ms << " ms, " << identifiers << " identifiers" << endl;
+    return depth ? 0 : 1;
+}
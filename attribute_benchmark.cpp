@@ -0,0 +1,246 @@
+// Reports the size of the attribute records and counts the heap
+// allocations of the full analysis of a file, by replacing the global
+// operator new, along with its time.
+//
+// The records used to own their dimension and parameter lists and the
+// text of string literals. To compare, the rules the analysis ran are
+// replayed on a copy of that layout and on the current one: copy rules
+// copy a whole record, and the rules that grow a list or keep a string
+// do so. Each rule writes a new record, as it did into the one the
+// expansion of its production pushed.
+//
+//   attribute_benchmark <file> [repetitions]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "analyzer.h"
+#include "command_line.h"
+
+
+using namespace std;
+
+
+static atomic<size_t> allocations{0};
+static atomic<size_t> allocated_bytes{0};
+
+
+void *operator new(size_t size) {
+    ++allocations;
+    allocated_bytes += size;
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+
+
+// SymbolAttributes as it was before the lists moved to the type table.
+struct OldAttributes {
+    struct TypeDim {
+        Type type = Type::VOID;
+        vector<size_t> dimension;
+    };
+
+    bool is_const = false;
+    bool is_function = false;
+    TypeDim type_dim;
+    bool bool_value = false;
+    long int_value = 0;
+    double float_value = 0;
+    char rune_value = 0;
+    string str_value;
+    vector<TypeDim> params;
+    size_t line_no = 0;
+    TypeDim return_type_dim;
+    bool in_loop = false;
+    bool is_lvalue = false;
+    bool is_literal = false;
+    bool three_for = false;
+    uint32_t identifier = 0;
+    Operation operation = Operation::NONE;
+};
+
+
+// What the rules that fill lists and strings do to each layout.
+struct OldLayout {
+    using Record = OldAttributes;
+
+    static void add_dimension(Record &to, const Record &from, size_t length) {
+        to.type_dim.dimension = from.type_dim.dimension;
+        to.type_dim.dimension.push_back(length);
+    }
+
+    static void add_parameter(Record &to, const Record &from, const Record &type) {
+        to.params = from.params;
+        to.params.push_back(type.type_dim);
+    }
+
+    static void set_string(Record &to, string_view text) {
+        to.str_value = string(text);
+    }
+};
+
+
+struct NewLayout {
+    using Record = SymbolAttributes;
+
+    void add_dimension(Record &to, const Record &from, size_t length) {
+        to.type_dim = types.add_dimension(from.type_dim, length);
+    }
+
+    void add_parameter(Record &to, const Record &from, const Record &type) {
+        to.params = types.add_parameter(from.params, type.type_dim);
+    }
+
+    static void set_string(Record &to, string_view) {
+        to.type_dim = TypeTable::scalar(Type::STRING);
+    }
+
+    TypeTable types;
+};
+
+
+// Runs rules on a stack of records per symbol. Only the lists need the
+// stacks to be right: a type or parameter list grows by a record pushed
+// for each nested production, which its copy-back pops. Every other rule
+// writes a new record in place. String literals are taken from tokens in
+// order.
+template <typename Layout>
+static void replay(const vector<int> &rules, TokenBuffer &tokens) {
+    using Record = typename Layout::Record;
+    Layout layout;
+    vector<vector<Record>> stacks(SyntaxSymbol::NUM_OF_SYMBOLS);
+    auto slot = [&stacks](int symbol, int r_idx = 0) -> Record & {
+        vector<Record> &stack = stacks[symbol];
+        if (stack.size() <= (size_t)r_idx)
+            stack.insert(stack.begin(), r_idx + 1 - stack.size(), Record());
+        return stack[stack.size() - 1 - r_idx];
+    };
+    size_t next_string = 0;
+    bool in_type = false;
+
+    for (int rule : rules) {
+        // The precedence climbing records operations after the rules.
+        if (rule >= NUM_OF_SEMANTIC_RULES)
+            continue;
+        const RuleSlots &slots = rule_slots[rule];
+        // The lengths do not matter to either layout.
+        if (rule == 15) {
+            // Only a dimension inside another adds to its type.
+            if (not in_type)
+                slot(SyntaxSymbol::TYPEp) = Record();
+            stacks[SyntaxSymbol::TYPEp].emplace_back();
+            layout.add_dimension(slot(SyntaxSymbol::TYPEp), slot(SyntaxSymbol::TYPEp, 1), 4);
+        } else if (rule == 23 or rule == 25) {
+            if (rule == 23)
+                slot(SyntaxSymbol::PARAM_LIST) = Record();
+            else
+                stacks[SyntaxSymbol::PARAM_LISTp].emplace_back();
+            slot(SyntaxSymbol::PARAM_LISTp) = Record();
+            layout.add_parameter(slot(SyntaxSymbol::PARAM_LISTp), rule == 23 ? slot(SyntaxSymbol::PARAM_LIST) :
+                                 slot(SyntaxSymbol::PARAM_LISTp, 1), slot(SyntaxSymbol::TYPEp));
+        } else if (slots.is_copy) {
+            Record &to = slot(slots.slots[0].symbol, slots.slots[0].r_idx);
+            to = Record(slot(slots.slots[1].symbol, slots.slots[1].r_idx));
+            if (rule == 16 or rule == 26)
+                stacks[slots.slots[1].symbol].pop_back();
+        } else if (slots.count > 0) {
+            slot(slots.slots[0].symbol, slots.slots[0].r_idx) = Record();
+            if (rule == 114 or rule == 115) {
+                while (next_string < tokens.size() and tokens.get_token(next_string) != Token::STRING and
+                       tokens.get_token(next_string) != Token::R_STRING)
+                    ++next_string;
+                if (next_string < tokens.size())
+                    layout.set_string(slot(SyntaxSymbol::TERM), tokens.get_lexeme(next_string++));
+            }
+        }
+        if (rule >= 15 and rule <= 17)
+            in_type = rule == 15;
+    }
+}
+
+
+// Allocations, bytes allocated and milliseconds of a replay.
+struct ReplayCost {
+    size_t allocations;
+    size_t bytes;
+    double ms;
+};
+
+
+template <typename Layout>
+static ReplayCost replay_cost(const vector<int> &rules, TokenBuffer &tokens, int repetitions) {
+    size_t before = allocations, before_bytes = allocated_bytes;
+    replay<Layout>(rules, tokens);
+    ReplayCost cost{allocations - before, allocated_bytes - before_bytes, 0};
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        replay<Layout>(rules, tokens);
+    cost.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+    return cost;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <file> [repetitions]" << endl;
+        return 1;
+    }
+    int repetitions = parse_repetitions(argc, argv, 2, 5);
+    if (repetitions == 0)
+        return 1;
+
+    SourceCode source_code(argv[1]);
+    TokenBuffer tokens(&source_code);
+    // The diagnostics are not what is being timed.
+    cerr.rdbuf(nullptr);
+
+    vector<int> rules;
+    size_t before = allocations, before_bytes = allocated_bytes;
+    Analyzer traced(&tokens);
+    traced.trace_rules(&rules);
+    bool result = traced.analyze();
+    size_t count = allocations - before, bytes = allocated_bytes - before_bytes;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        Analyzer(&tokens).analyze();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+
+    cout << tokens.size() << " tokens" << (result ? "" : ", rejected") << endl;
+    cout << sizeof(SymbolAttributes) << " bytes per attribute record, " << sizeof(SymbolTableRecord) <<
+            " per symbol table record" << endl;
+    cout << count << " allocations, " << (double)count / tokens.size() << " per token, " <<
+            (double)bytes / tokens.size() << " bytes per token" << endl;
+    cout << ms << " ms, " << tokens.size() / ms / 1e3 << " Mtokens/s" << endl;
+
+    ReplayCost old_cost = replay_cost<OldLayout>(rules, tokens, repetitions);
+    ReplayCost new_cost = replay_cost<NewLayout>(rules, tokens, repetitions);
+    auto row = [](const char *name, double before, double after) {
+        cout << left << setw(28) << name << right << setw(12) << before << setw(12) << after << endl;
+    };
+    cout << "replay of " << rules.size() << " rules" << endl;
+    cout << setw(40) << "before" << setw(12) << "after" << endl;
+    row("bytes per attribute record", sizeof(OldAttributes), sizeof(SymbolAttributes));
+    row("allocations per token", (double)old_cost.allocations / tokens.size(),
+        (double)new_cost.allocations / tokens.size());
+    row("bytes allocated per token", (double)old_cost.bytes / tokens.size(), (double)new_cost.bytes / tokens.size());
+    row("ms", old_cost.ms, new_cost.ms);
+    return 0;
+}
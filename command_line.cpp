@@ -0,0 +1,24 @@
+#include <charconv>
+#include <climits>
+#include <iostream>
+
+#include "command_line.h"
+
+
+bool parse_count(std::string_view text, std::size_t &count) {
+    const char *last = text.data() + text.size();
+    auto result = std::from_chars(text.data(), last, count);
+    return result.ec == std::errc() and result.ptr == last;
+}
+
+
+int parse_repetitions(int argc, char *argv[], int index, int default_repetitions) {
+    if (argc <= index)
+        return default_repetitions;
+    std::size_t repetitions;
+    if (not parse_count(argv[index], repetitions) or repetitions == 0 or repetitions > INT_MAX) {
+        std::cerr << "Repetitions must be a positive number." << std::endl;
+        return 0;
+    }
+    return (int)repetitions;
+}
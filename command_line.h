@@ -0,0 +1,15 @@
+#ifndef ALGO_COMMAND_LINE_H
+#define ALGO_COMMAND_LINE_H
+
+#include <cstddef>
+#include <string_view>
+
+
+// Parses text, which must be all digits, into count.
+bool parse_count(std::string_view text, std::size_t &count);
+
+// The repetitions a benchmark is given as its argument at index, or
+// default_repetitions without one. Reports a bad one and returns 0.
+int parse_repetitions(int argc, char *argv[], int index, int default_repetitions);
+
+#endif //ALGO_COMMAND_LINE_H
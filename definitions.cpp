@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "perfect_hash.h"
 
 
 const int Token::NUM_OF_TOKENS = SyntaxSymbol::FIRST_NON_TERMINAL;
@@ -7,134 +8,145 @@ const int SyntaxSymbol::FIRST_NON_TERMINAL = PACKAGE;
 const int SyntaxSymbol::NUM_OF_SYMBOLS = FOR_CONSTpp + 1;
 
 
-const std::map<std::string, int> SyntaxSymbol::str_to_value{
-        {"NONE", NONE},
-        {"COL", COL},
-        {"DOT", DOT},
-        {"SEMICOL", SEMICOL},
-        {"O_PAREN", O_PAREN},
-        {"C_PAREN", C_PAREN},
-        {"O_BRACK", O_BRACK},
-        {"C_BRACK", C_BRACK},
-        {"O_SQBRACK", O_SQBRACK},
-        {"C_SQBRACK", C_SQBRACK},
-        {"PLUS", PLUS},
-        {"MINUS", MINUS},
-        {"TIMES", TIMES},
-        {"DIV", DIV},
-        {"MOD", MOD},
-        {"BW_AND", BW_AND},
-        {"BW_AND_NOT", BW_AND_NOT},
-        {"BW_OR", BW_OR},
-        {"BW_XOR_NEG", BW_XOR_NEG},
-        {"L_SHIFT", L_SHIFT},
-        {"R_SHIFT", R_SHIFT},
-        {"A_PLUS", A_PLUS},
-        {"A_MINUS", A_MINUS},
-        {"A_TIMES", A_TIMES},
-        {"A_DIV", A_DIV},
-        {"A_MOD", A_MOD},
-        {"A_BW_AND", A_BW_AND},
-        {"A_BW_AND_NOT", A_BW_AND_NOT},
-        {"A_BW_OR", A_BW_OR},
-        {"A_BW_XOR", A_BW_XOR},
-        {"A_L_SHIFT", A_L_SHIFT},
-        {"A_R_SHIFT", A_R_SHIFT},
-        {"INCR", INCR},
-        {"DECR", DECR},
-        {"ASSIGN", ASSIGN},
-        {"EQ", EQ},
-        {"NEQ", NEQ},
-        {"LT", LT},
-        {"GT", GT},
-        {"LTE", LTE},
-        {"GTE", GTE},
-        {"OR", OR},
-        {"AND", AND},
-        {"NOT", NOT},
-        {"IDENT", IDENT},
-        {"DEC", DEC},
-        {"OCTAL", OCTAL},
-        {"HEXADEC", HEXADEC},
-        {"FLOAT", FLOAT},
-        {"RUNE", RUNE},
-        {"STRING", STRING},
-        {"R_STRING", R_STRING},
-        {"TRUE", TRUE},
-        {"FALSE", FALSE},
-        {"CONST", CONST},
-        {"VAR", VAR},
-        {"FOR", FOR},
-        {"IF", IF},
-        {"ELSE", ELSE},
-        {"BREAK", BREAK},
-        {"CONTINUE", CONTINUE},
-        {"RETURN", RETURN},
-        {"FUNC", FUNC},
-        {"PKG", PKG},
-        {"IMP", IMP},
-        {"BOOL", BOOL},
-        {"INT", INT},
-        {"I32", I32},
-        {"I64", I64},
-        {"UINT", UINT},
-        {"UI32", UI32},
-        {"UI64", UI64},
-        {"FL32", FL32},
-        {"FL64", FL64},
-        {"RN", RN},
-        {"STR", STR},
-        {"PACKAGE", PACKAGE},
-        {"IMPORT_DECLS", IMPORT_DECLS},
-        {"PKG_DECLS", PKG_DECLS},
-        {"CONST_DECL", CONST_DECL},
-        {"VAR_DECL", VAR_DECL},
-        {"TYPEp", TYPEp},
-        {"VAR_DECLp", VAR_DECLp},
-        {"INT_LIT", INT_LIT},
-        {"FUNC_DECL", FUNC_DECL},
-        {"FUNC_DECLp", FUNC_DECLp},
-        {"PARAM_LIST", PARAM_LIST},
-        {"PARAM_LISTp", PARAM_LISTp},
-        {"BLOCK", BLOCK},
-        {"TYPE", TYPE},
-        {"BLOCK_CONTS", BLOCK_CONTS},
-        {"BLOCK_UNIT", BLOCK_UNIT},
-        {"RETURNp", RETURNp},
-        {"EXPR", EXPR},
-        {"EXPRp", EXPRp},
-        {"ASSIGN_OPER", ASSIGN_OPER},
-        {"LV1EXPR", LV1EXPR},
-        {"LV1EXPRp", LV1EXPRp},
-        {"LV1OPER", LV1OPER},
-        {"LV2EXPR", LV2EXPR},
-        {"LV2EXPRp", LV2EXPRp},
-        {"LV2OPER", LV2OPER},
-        {"LV3EXPR", LV3EXPR},
-        {"LV3EXPRp", LV3EXPRp},
-        {"LV3OPER", LV3OPER},
-        {"LV4EXPR", LV4EXPR},
-        {"LV4EXPRp", LV4EXPRp},
-        {"LV4OPER", LV4OPER},
-        {"LV5EXPR", LV5EXPR},
-        {"LV5EXPRp", LV5EXPRp},
-        {"LV5OPER", LV5OPER},
-        {"UNARYOPER", UNARYOPER},
-        {"TERM", TERM},
-        {"IDCR", IDCR},
-        {"CAST", CAST},
-        {"ARR_LIT", ARR_LIT},
-        {"LIST", LIST},
-        {"LISTp", LISTp},
-        {"ACCESS", ACCESS},
-        {"FUNC_CALL", FUNC_CALL},
-        {"ARRAY_ACC", ARRAY_ACC},
-        {"PARAMS", PARAMS},
-        {"PARAMSp", PARAMSp},
-        {"IF_CONST", IF_CONST},
-        {"IF_CONSTp", IF_CONSTp},
-        {"ELSEp", ELSEp},
-        {"FOR_CONST", FOR_CONST},
-        {"FOR_CONSTp", FOR_CONSTp},
-        {"FOR_CONSTpp", FOR_CONSTpp}
+typedef PerfectHash<32, 256> SymbolNames;
+
+
+constexpr SymbolNames::Entry symbol_name_entries[] = {
+        {"NONE", SyntaxSymbol::NONE},
+        {"COL", SyntaxSymbol::COL},
+        {"DOT", SyntaxSymbol::DOT},
+        {"SEMICOL", SyntaxSymbol::SEMICOL},
+        {"O_PAREN", SyntaxSymbol::O_PAREN},
+        {"C_PAREN", SyntaxSymbol::C_PAREN},
+        {"O_BRACK", SyntaxSymbol::O_BRACK},
+        {"C_BRACK", SyntaxSymbol::C_BRACK},
+        {"O_SQBRACK", SyntaxSymbol::O_SQBRACK},
+        {"C_SQBRACK", SyntaxSymbol::C_SQBRACK},
+        {"PLUS", SyntaxSymbol::PLUS},
+        {"MINUS", SyntaxSymbol::MINUS},
+        {"TIMES", SyntaxSymbol::TIMES},
+        {"DIV", SyntaxSymbol::DIV},
+        {"MOD", SyntaxSymbol::MOD},
+        {"BW_AND", SyntaxSymbol::BW_AND},
+        {"BW_AND_NOT", SyntaxSymbol::BW_AND_NOT},
+        {"BW_OR", SyntaxSymbol::BW_OR},
+        {"BW_XOR_NEG", SyntaxSymbol::BW_XOR_NEG},
+        {"L_SHIFT", SyntaxSymbol::L_SHIFT},
+        {"R_SHIFT", SyntaxSymbol::R_SHIFT},
+        {"A_PLUS", SyntaxSymbol::A_PLUS},
+        {"A_MINUS", SyntaxSymbol::A_MINUS},
+        {"A_TIMES", SyntaxSymbol::A_TIMES},
+        {"A_DIV", SyntaxSymbol::A_DIV},
+        {"A_MOD", SyntaxSymbol::A_MOD},
+        {"A_BW_AND", SyntaxSymbol::A_BW_AND},
+        {"A_BW_AND_NOT", SyntaxSymbol::A_BW_AND_NOT},
+        {"A_BW_OR", SyntaxSymbol::A_BW_OR},
+        {"A_BW_XOR", SyntaxSymbol::A_BW_XOR},
+        {"A_L_SHIFT", SyntaxSymbol::A_L_SHIFT},
+        {"A_R_SHIFT", SyntaxSymbol::A_R_SHIFT},
+        {"INCR", SyntaxSymbol::INCR},
+        {"DECR", SyntaxSymbol::DECR},
+        {"ASSIGN", SyntaxSymbol::ASSIGN},
+        {"EQ", SyntaxSymbol::EQ},
+        {"NEQ", SyntaxSymbol::NEQ},
+        {"LT", SyntaxSymbol::LT},
+        {"GT", SyntaxSymbol::GT},
+        {"LTE", SyntaxSymbol::LTE},
+        {"GTE", SyntaxSymbol::GTE},
+        {"OR", SyntaxSymbol::OR},
+        {"AND", SyntaxSymbol::AND},
+        {"NOT", SyntaxSymbol::NOT},
+        {"IDENT", SyntaxSymbol::IDENT},
+        {"DEC", SyntaxSymbol::DEC},
+        {"OCTAL", SyntaxSymbol::OCTAL},
+        {"HEXADEC", SyntaxSymbol::HEXADEC},
+        {"FLOAT", SyntaxSymbol::FLOAT},
+        {"RUNE", SyntaxSymbol::RUNE},
+        {"STRING", SyntaxSymbol::STRING},
+        {"R_STRING", SyntaxSymbol::R_STRING},
+        {"TRUE", SyntaxSymbol::TRUE},
+        {"FALSE", SyntaxSymbol::FALSE},
+        {"CONST", SyntaxSymbol::CONST},
+        {"VAR", SyntaxSymbol::VAR},
+        {"FOR", SyntaxSymbol::FOR},
+        {"IF", SyntaxSymbol::IF},
+        {"ELSE", SyntaxSymbol::ELSE},
+        {"BREAK", SyntaxSymbol::BREAK},
+        {"CONTINUE", SyntaxSymbol::CONTINUE},
+        {"RETURN", SyntaxSymbol::RETURN},
+        {"FUNC", SyntaxSymbol::FUNC},
+        {"PKG", SyntaxSymbol::PKG},
+        {"IMP", SyntaxSymbol::IMP},
+        {"BOOL", SyntaxSymbol::BOOL},
+        {"INT", SyntaxSymbol::INT},
+        {"I32", SyntaxSymbol::I32},
+        {"I64", SyntaxSymbol::I64},
+        {"UINT", SyntaxSymbol::UINT},
+        {"UI32", SyntaxSymbol::UI32},
+        {"UI64", SyntaxSymbol::UI64},
+        {"FL32", SyntaxSymbol::FL32},
+        {"FL64", SyntaxSymbol::FL64},
+        {"RN", SyntaxSymbol::RN},
+        {"STR", SyntaxSymbol::STR},
+        {"ERROR", SyntaxSymbol::ERROR},
+        {"PACKAGE", SyntaxSymbol::PACKAGE},
+        {"IMPORT_DECLS", SyntaxSymbol::IMPORT_DECLS},
+        {"PKG_DECLS", SyntaxSymbol::PKG_DECLS},
+        {"CONST_DECL", SyntaxSymbol::CONST_DECL},
+        {"VAR_DECL", SyntaxSymbol::VAR_DECL},
+        {"TYPEp", SyntaxSymbol::TYPEp},
+        {"VAR_DECLp", SyntaxSymbol::VAR_DECLp},
+        {"INT_LIT", SyntaxSymbol::INT_LIT},
+        {"FUNC_DECL", SyntaxSymbol::FUNC_DECL},
+        {"FUNC_DECLp", SyntaxSymbol::FUNC_DECLp},
+        {"PARAM_LIST", SyntaxSymbol::PARAM_LIST},
+        {"PARAM_LISTp", SyntaxSymbol::PARAM_LISTp},
+        {"BLOCK", SyntaxSymbol::BLOCK},
+        {"TYPE", SyntaxSymbol::TYPE},
+        {"BLOCK_CONTS", SyntaxSymbol::BLOCK_CONTS},
+        {"BLOCK_UNIT", SyntaxSymbol::BLOCK_UNIT},
+        {"RETURNp", SyntaxSymbol::RETURNp},
+        {"EXPR", SyntaxSymbol::EXPR},
+        {"EXPRp", SyntaxSymbol::EXPRp},
+        {"ASSIGN_OPER", SyntaxSymbol::ASSIGN_OPER},
+        {"LV1EXPR", SyntaxSymbol::LV1EXPR},
+        {"LV1EXPRp", SyntaxSymbol::LV1EXPRp},
+        {"LV1OPER", SyntaxSymbol::LV1OPER},
+        {"LV2EXPR", SyntaxSymbol::LV2EXPR},
+        {"LV2EXPRp", SyntaxSymbol::LV2EXPRp},
+        {"LV2OPER", SyntaxSymbol::LV2OPER},
+        {"LV3EXPR", SyntaxSymbol::LV3EXPR},
+        {"LV3EXPRp", SyntaxSymbol::LV3EXPRp},
+        {"LV3OPER", SyntaxSymbol::LV3OPER},
+        {"LV4EXPR", SyntaxSymbol::LV4EXPR},
+        {"LV4EXPRp", SyntaxSymbol::LV4EXPRp},
+        {"LV4OPER", SyntaxSymbol::LV4OPER},
+        {"LV5EXPR", SyntaxSymbol::LV5EXPR},
+        {"LV5EXPRp", SyntaxSymbol::LV5EXPRp},
+        {"LV5OPER", SyntaxSymbol::LV5OPER},
+        {"UNARYOPER", SyntaxSymbol::UNARYOPER},
+        {"TERM", SyntaxSymbol::TERM},
+        {"IDCR", SyntaxSymbol::IDCR},
+        {"CAST", SyntaxSymbol::CAST},
+        {"ARR_LIT", SyntaxSymbol::ARR_LIT},
+        {"LIST", SyntaxSymbol::LIST},
+        {"LISTp", SyntaxSymbol::LISTp},
+        {"ACCESS", SyntaxSymbol::ACCESS},
+        {"FUNC_CALL", SyntaxSymbol::FUNC_CALL},
+        {"ARRAY_ACC", SyntaxSymbol::ARRAY_ACC},
+        {"PARAMS", SyntaxSymbol::PARAMS},
+        {"PARAMSp", SyntaxSymbol::PARAMSp},
+        {"IF_CONST", SyntaxSymbol::IF_CONST},
+        {"IF_CONSTp", SyntaxSymbol::IF_CONSTp},
+        {"ELSEp", SyntaxSymbol::ELSEp},
+        {"FOR_CONST", SyntaxSymbol::FOR_CONST},
+        {"FOR_CONSTp", SyntaxSymbol::FOR_CONSTp},
+        {"FOR_CONSTpp", SyntaxSymbol::FOR_CONSTpp}
 };
+
+constexpr SymbolNames symbol_names = SymbolNames::build(symbol_name_entries);
+static_assert(symbol_names.is_complete(), "grammar symbol names need a different hash");
+
+
+SyntaxSymbol::SyntaxSymbol(std::string_view name) :
+        Token(symbol_names.find(name, NONE)) { }
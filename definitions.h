@@ -1,7 +1,7 @@
 #ifndef ALGO_DEFINITIONS_H
 #define ALGO_DEFINITIONS_H
 
-#include <map>
+#include <string_view>
 
 
 class Token {
@@ -83,6 +83,8 @@ public:
         FL64,
         RN,
         STR,
+        // A malformed lexeme; never part of the grammar.
+        ERROR,
     };
 
     Token(int value = NONE) : value(value) { }
@@ -95,6 +97,10 @@ public:
         return value >= IDENT and value <= R_STRING;
     }
 
+    bool is_literal() const {
+        return value >= DEC and value <= R_STRING;
+    }
+
     static const int NUM_OF_TOKENS;
 
 protected:
@@ -105,7 +111,7 @@ protected:
 class SyntaxSymbol : public Token {
 public:
     enum _SyntaxSymbol {
-        PACKAGE = Token::STR + 1,
+        PACKAGE = Token::ERROR + 1,
         IMPORT_DECLS,
         PKG_DECLS,
         CONST_DECL,
@@ -162,10 +168,7 @@ public:
 
     SyntaxSymbol(int value = NONE) : Token(value) { }
 
-    SyntaxSymbol(const std::string name) {
-        auto it = str_to_value.find(name);
-        value = it != str_to_value.end() ? it->second : NONE;
-    }
+    explicit SyntaxSymbol(std::string_view name);
 
     bool is_terminal() const {
         return value < FIRST_NON_TERMINAL;
@@ -173,9 +176,6 @@ public:
 
     static const int FIRST_NON_TERMINAL;
     static const int NUM_OF_SYMBOLS;
-
-private:
-    static const std::map<std::string, int> str_to_value;
 };
 
 enum class Type {
@@ -0,0 +1,230 @@
+// Runs the table-driven engine and the generated recursive-descent one on
+// the same tokens and checks that they run the same semantic rules in the
+// same order and report the same diagnostics. The copy rules are left out
+// of the comparison, since the table-driven loop elides some of them.
+// The descent engine stops at the first syntax error, so on input with
+// one, what it did only has to be a prefix of what the other did.
+//
+// Without files, checks programs derived at random from the grammar, each
+// also with a token dropped.
+//
+//   descent_trace_check [file...]
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "analyzer.h"
+
+
+using namespace std;
+
+
+static const pair<int, const char *> SPELLINGS[] = {
+        {Token::COL, ","}, {Token::DOT, "."}, {Token::SEMICOL, ";"},
+        {Token::O_PAREN, "("}, {Token::C_PAREN, ")"}, {Token::O_BRACK, "{"}, {Token::C_BRACK, "}"},
+        {Token::O_SQBRACK, "["}, {Token::C_SQBRACK, "]"},
+        {Token::PLUS, "+"}, {Token::MINUS, "-"}, {Token::TIMES, "*"}, {Token::DIV, "/"}, {Token::MOD, "%"},
+        {Token::BW_AND, "&"}, {Token::BW_AND_NOT, "&^"}, {Token::BW_OR, "|"}, {Token::BW_XOR_NEG, "^"},
+        {Token::L_SHIFT, "<<"}, {Token::R_SHIFT, ">>"},
+        {Token::A_PLUS, "+="}, {Token::A_MINUS, "-="}, {Token::A_TIMES, "*="}, {Token::A_DIV, "/="},
+        {Token::A_MOD, "%="}, {Token::A_BW_AND, "&="}, {Token::A_BW_AND_NOT, "&^="}, {Token::A_BW_OR, "|="},
+        {Token::A_BW_XOR, "^="}, {Token::A_L_SHIFT, "<<="}, {Token::A_R_SHIFT, ">>="},
+        {Token::INCR, "++"}, {Token::DECR, "--"}, {Token::ASSIGN, "="},
+        {Token::EQ, "=="}, {Token::NEQ, "!="}, {Token::LT, "<"}, {Token::GT, ">"}, {Token::LTE, "<="},
+        {Token::GTE, ">="}, {Token::OR, "||"}, {Token::AND, "&&"}, {Token::NOT, "!"},
+        {Token::DEC, "3"}, {Token::OCTAL, "017"}, {Token::HEXADEC, "0x1f"}, {Token::FLOAT, "2.5"},
+        {Token::RUNE, "'c'"}, {Token::STRING, "\"s\""}, {Token::R_STRING, "`r`"},
+        {Token::TRUE, "true"}, {Token::FALSE, "false"}, {Token::CONST, "const"}, {Token::VAR, "var"},
+        {Token::FOR, "for"}, {Token::IF, "if"}, {Token::ELSE, "else"}, {Token::BREAK, "break"},
+        {Token::CONTINUE, "continue"}, {Token::RETURN, "return"}, {Token::FUNC, "func"},
+        {Token::PKG, "package"}, {Token::IMP, "import"},
+        {Token::BOOL, "bool"}, {Token::INT, "int"}, {Token::I32, "int32"}, {Token::I64, "int64"},
+        {Token::UINT, "uint"}, {Token::UI32, "uint32"}, {Token::UI64, "uint64"},
+        {Token::FL32, "float32"}, {Token::FL64, "float64"}, {Token::RN, "rune"}, {Token::STR, "string"}
+};
+
+// Few names, so that they are often declared and used.
+static const char *const NAMES[] = {"a", "b", "f", "main"};
+
+
+// Derives sentences of the grammar at random, with the productions the
+// parse table selects. Past max_depth, each non-terminal takes the
+// production with the shortest derivation, so that sentences end.
+class SentenceGenerator {
+public:
+    SentenceGenerator(unsigned seed, int max_depth) : random(seed), max_depth(max_depth) {
+        for (int row = 0; row < grammar::NUM_OF_NON_TERMINALS; ++row)
+            for (std::int16_t production : grammar::parse_table[row])
+                if (production != grammar::NO_PRODUCTION and
+                    find(productions[row].begin(), productions[row].end(), production) == productions[row].end())
+                    productions[row].push_back(production);
+
+        // Lengths of the shortest derivations, until they settle.
+        fill(begin(shortest), end(shortest), UNKNOWN);
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (int row = 0; row < grammar::NUM_OF_NON_TERMINALS; ++row)
+                for (int production : productions[row])
+                    if (_length(production) < shortest[row]) {
+                        shortest[row] = _length(production);
+                        changed = true;
+                    }
+        }
+    }
+
+    vector<Token> derive() {
+        vector<Token> tokens;
+        _derive(SyntaxSymbol::PACKAGE, 0, tokens);
+        return tokens;
+    }
+
+private:
+    static constexpr int UNKNOWN = 1 << 20;
+
+    // The symbols of a production, from the left.
+    static vector<int> _symbols(int production) {
+        vector<int> symbols;
+        for (int i = grammar::symbol_starts[production + 1] - 1; i >= grammar::symbol_starts[production]; --i)
+            symbols.push_back(grammar::symbol_items[i].value());
+        return symbols;
+    }
+
+    int _length(int production) const {
+        int length = 0;
+        for (int symbol : _symbols(production))
+            length += SyntaxSymbol(symbol).is_terminal() ? 1 : shortest[symbol - SyntaxSymbol::FIRST_NON_TERMINAL];
+        return min(length, UNKNOWN);
+    }
+
+    void _derive(int symbol, int depth, vector<Token> &tokens) {
+        if (SyntaxSymbol(symbol).is_terminal()) {
+            tokens.push_back(symbol);
+            return;
+        }
+        int row = symbol - SyntaxSymbol::FIRST_NON_TERMINAL;
+        const vector<int> &choices = productions[row];
+        uniform_int_distribution<size_t> choice(0, choices.size() - 1);
+        int production = choices[choice(random)];
+        // Lists would mostly end right away otherwise.
+        if (depth <= max_depth and _length(production) == shortest[row])
+            production = choices[choice(random)];
+        if (depth > max_depth)
+            for (int choice : choices)
+                if (_length(choice) < _length(production))
+                    production = choice;
+        for (int item : _symbols(production))
+            _derive(item, depth + 1, tokens);
+    }
+
+    mt19937 random;
+    int max_depth;
+    vector<int> productions[grammar::NUM_OF_NON_TERMINALS];
+    int shortest[grammar::NUM_OF_NON_TERMINALS];
+};
+
+
+static string spell(const vector<Token> &tokens, unsigned seed) {
+    mt19937 random(seed);
+    string spellings[Token::ERROR];
+    for (const auto &spelling : SPELLINGS)
+        spellings[spelling.first] = spelling.second;
+    string code;
+    for (Token token : tokens) {
+        if (token == Token::IDENT)
+            code += NAMES[uniform_int_distribution<size_t>(0, size(NAMES) - 1)(random)];
+        else
+            code += spellings[token];
+        code += token == Token::SEMICOL or token == Token::O_BRACK or token == Token::C_BRACK ? "\n" : " ";
+    }
+    return code;
+}
+
+
+// Rules and diagnostics of an engine on the tokens.
+struct Run {
+    bool result;
+    vector<int> rules;
+    string diagnostics;
+};
+
+
+static Run run(TokenBuffer &tokens, bool descent) {
+    ostringstream out;
+    Run run;
+    {
+        Diagnostics diagnostics(&out, Diagnostics::Format::COMPACT);
+        Analyzer analyzer(&tokens);
+        analyzer.report_to(&diagnostics);
+        analyzer.trace_rules(&run.rules);
+        run.result = descent ? analyzer.analyze_descent() : analyzer.analyze();
+    }
+    run.rules.erase(remove_if(run.rules.begin(), run.rules.end(), [](int rule) {
+        return rule < NUM_OF_SEMANTIC_RULES and rule_slots[rule].is_copy;
+    }), run.rules.end());
+    run.diagnostics = out.str();
+    return run;
+}
+
+
+static bool is_prefix(const string &prefix, const string &text) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+
+static bool check(const string &filename, size_t &syntax_errors) {
+    SourceCode source_code(filename);
+    TokenBuffer tokens(&source_code);
+    Run table = run(tokens, false), descent = run(tokens, true);
+
+    // Syntax errors are the only ones with the token found as a field.
+    bool stopped = descent.diagnostics.find("\tunexpected-token\t") != string::npos;
+    syntax_errors += stopped;
+    string problem;
+    if (descent.rules.size() > table.rules.size() or
+        not equal(descent.rules.begin(), descent.rules.end(), table.rules.begin()))
+        problem = "the rules differ at rule " + to_string(
+                mismatch(descent.rules.begin(), descent.rules.end(), table.rules.begin(), table.rules.end()).first -
+                descent.rules.begin());
+    else if (not is_prefix(descent.diagnostics, table.diagnostics))
+        problem = "the diagnostics differ";
+    else if (not stopped and (descent.rules.size() != table.rules.size() or
+                              descent.diagnostics != table.diagnostics or descent.result != table.result))
+        problem = "the engines disagree";
+
+    if (problem.empty())
+        return true;
+    cout << filename << ": " << problem << endl;
+    return false;
+}
+
+
+int main(int argc, char *argv[]) {
+    bool ok = true;
+    size_t checked = 0, syntax_errors = 0;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i, ++checked)
+            ok = check(argv[i], syntax_errors) and ok;
+    } else {
+        string filename = (filesystem::temp_directory_path() / "descent_trace_check.algo").string();
+        for (unsigned seed = 1; seed <= 200; ++seed) {
+            vector<Token> sentence = SentenceGenerator(seed, 12).derive();
+            ofstream(filename) << spell(sentence, seed);
+            ok = check(filename, syntax_errors) and ok;
+            sentence.erase(sentence.begin() + seed * 7919 % sentence.size());
+            ofstream(filename) << spell(sentence, seed);
+            ok = check(filename, syntax_errors) and ok;
+            checked += 2;
+        }
+        remove(filename.c_str());
+    }
+    cout << checked << " files, " << syntax_errors << " with syntax errors, " << (ok ? "ok" : "failed") << endl;
+    return ok ? 0 : 1;
+}
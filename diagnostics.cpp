@@ -0,0 +1,117 @@
+#include <sstream>
+
+#include "definitions.h"
+#include "diagnostics.h"
+
+
+namespace {
+
+// Messages of the semantic diagnostics, around their text.
+struct Message {
+    const char *name;
+    const char *before;
+    const char *after;
+};
+
+const Message messages[] = {
+        {"unknown-lexeme", "", ""},
+        {"unexpected-token", "", ""},
+        {"redeclaration", "Redeclaration of \"", "\""},
+        {"integer-out-of-range", "Integer literal out of range", ""},
+        {"float-out-of-range", "Float literal out of range", ""},
+        {"not-inside-loop", "Statement not inside a loop", ""},
+        {"dimensions-mismatch", "Dimensions mismatch", ""},
+        {"types-mismatch", "Types mismatch", ""},
+        {"operator-for-strings", "Can't use operator for strings", ""},
+        {"operator-for-runes", "Can't use operator for runes", ""},
+        {"operator-for-arrays", "Can't use operator for arrays", ""},
+        {"operator-for-floats", "Can't use operator for floats", ""},
+        {"operator-for-integers", "Can't use operator for integers", ""},
+        {"not-an-lvalue", "Expression not an lvalue", ""},
+        {"const-modified", "Can't modify a const value", ""},
+        {"unknown-identifier", "Unknown identifier \"", "\""},
+        {"is-a-function", "", " is a function"},
+        {"is-not-a-function", "", " is not a function"},
+        {"access-dimensions-mismatch", "Dimensions mismatch on access to ", ""},
+        {"invalid-index", "Not a valid index", ""},
+        {"not-a-boolean", "Not a boolean expression", ""},
+};
+
+static_assert(sizeof(messages) / sizeof(messages[0]) == (std::size_t)DiagnosticCode::NOT_A_BOOLEAN + 1,
+              "every DiagnosticCode needs its message");
+
+
+void write_escaped(std::ostream &out, std::string_view text) {
+    for (char c : text) {
+        if (c == '\t')
+            out << "\\t";
+        else if (c == '\n')
+            out << "\\n";
+        else if (c == '\\')
+            out << "\\\\";
+        else
+            out << c;
+    }
+}
+
+
+void write_compact(std::ostream &out, const Diagnostic &diagnostic) {
+    out << diagnostic.line_no << '\t' << messages[(int)diagnostic.code].name;
+    if (not diagnostic.text.empty() or diagnostic.code == DiagnosticCode::UNEXPECTED_TOKEN) {
+        out << '\t';
+        write_escaped(out, diagnostic.text);
+    }
+    if (diagnostic.code == DiagnosticCode::UNEXPECTED_TOKEN)
+        out << '\t' << diagnostic.token << '\t' << diagnostic.expected;
+    out << '\n';
+}
+
+}
+
+
+std::ostream &operator<<(std::ostream &out, const Diagnostic &diagnostic) {
+    if (diagnostic.code == DiagnosticCode::UNKNOWN_LEXEME)
+        return out << "Unknown lexeme \"" << diagnostic.text << "\"" << "at line " << diagnostic.line_no << ".";
+    if (diagnostic.code == DiagnosticCode::UNEXPECTED_TOKEN) {
+        out << "Unexpected token " << diagnostic.token << " <" << diagnostic.text << "> at line " <<
+                diagnostic.line_no << ".";
+        if (diagnostic.expected != Token::NONE)
+            out << " Expected token " << diagnostic.expected << ".";
+        return out;
+    }
+    const Message &message = messages[(int)diagnostic.code];
+    return out << message.before << diagnostic.text << message.after << " at line " << diagnostic.line_no;
+}
+
+
+Diagnostics::Diagnostics(std::ostream *out, Format format, std::size_t max_errors) :
+        out(out), format(format), max_errors(max_errors), reported(0) { }
+
+
+Diagnostics::~Diagnostics() {
+    flush();
+}
+
+
+void Diagnostics::take(Diagnostics &other) {
+    for (const Diagnostic &diagnostic : other.pending)
+        report(diagnostic);
+    other.pending.clear();
+}
+
+
+void Diagnostics::flush() {
+    if (not out or pending.empty())
+        return;
+    std::ostringstream batch;
+    for (const Diagnostic &diagnostic : pending) {
+        if (format == Format::COMPACT)
+            write_compact(batch, diagnostic);
+        else
+            batch << diagnostic << '\n';
+    }
+    pending.clear();
+    const std::string &text = batch.str();
+    out->write(text.data(), (std::streamsize)text.size());
+    out->flush();
+}
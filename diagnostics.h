@@ -0,0 +1,110 @@
+#ifndef ALGO_DIAGNOSTICS_H
+#define ALGO_DIAGNOSTICS_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+enum class DiagnosticCode : std::uint8_t {
+    UNKNOWN_LEXEME,
+    UNEXPECTED_TOKEN,
+    REDECLARATION,
+    INTEGER_OUT_OF_RANGE,
+    FLOAT_OUT_OF_RANGE,
+    NOT_INSIDE_LOOP,
+    DIMENSIONS_MISMATCH,
+    TYPES_MISMATCH,
+    OPERATOR_FOR_STRINGS,
+    OPERATOR_FOR_RUNES,
+    OPERATOR_FOR_ARRAYS,
+    OPERATOR_FOR_FLOATS,
+    OPERATOR_FOR_INTEGERS,
+    NOT_AN_LVALUE,
+    CONST_MODIFIED,
+    UNKNOWN_IDENTIFIER,
+    IS_A_FUNCTION,
+    IS_NOT_A_FUNCTION,
+    ACCESS_DIMENSIONS_MISMATCH,
+    INVALID_INDEX,
+    NOT_A_BOOLEAN
+};
+
+
+// A diagnostic as it is found; its message is only made when it is
+// written. text is the lexeme or the name the message is about, a slice
+// of the source code, which must outlive the diagnostic.
+struct Diagnostic {
+    DiagnosticCode code;
+    // Of UNEXPECTED_TOKEN, the token found and the one expected instead,
+    // Token::NONE when it is not just one.
+    std::uint16_t token;
+    std::uint16_t expected;
+    std::uint32_t line_no;
+    std::string_view text;
+};
+
+
+// Writes the message of the diagnostic.
+std::ostream &operator<<(std::ostream &out, const Diagnostic &diagnostic);
+
+
+// Collects the diagnostics of analyses and writes them in batches, so that
+// they are formatted all at once and the stream written once per batch.
+//
+// In the COMPACT format, each diagnostic is a line of tab-separated fields:
+// the line number, the code as a lowercase, dashed name, and the text if
+// the diagnostic has one, with tabs, newlines and backslashes escaped.
+// UNEXPECTED_TOKEN adds the numbers of the token found and expected.
+class Diagnostics {
+public:
+    enum class Format {
+        TEXT,
+        COMPACT
+    };
+
+    static constexpr std::size_t NO_LIMIT = SIZE_MAX;
+
+    // Without out, the diagnostics are only kept for another sink to take.
+    // Those past the first max_errors are dropped.
+    explicit Diagnostics(std::ostream *out = nullptr, Format format = Format::TEXT,
+                         std::size_t max_errors = NO_LIMIT);
+
+    virtual ~Diagnostics();
+
+    void report(const Diagnostic &diagnostic) {
+        if (reported == max_errors)
+            return;
+        ++reported;
+        pending.push_back(diagnostic);
+        if (out and pending.size() == BATCH)
+            flush();
+    }
+
+    // Whether max_errors were reported, after which analyses stop.
+    bool full() const {
+        return reported == max_errors;
+    }
+
+    std::size_t get_max_errors() const {
+        return max_errors;
+    }
+
+    // Reports what other kept, in order, and forgets it.
+    void take(Diagnostics &other);
+
+    void flush();
+
+private:
+    static constexpr std::size_t BATCH = 4096;
+
+    std::ostream *out;
+    Format format;
+    std::size_t max_errors;
+    std::size_t reported;
+    std::vector<Diagnostic> pending;
+};
+
+#endif //ALGO_DIAGNOSTICS_H
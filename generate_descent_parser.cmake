@@ -0,0 +1,158 @@
+# Turns productions.csv and syntactic_table.csv into a recursive-descent
+# parser: one member function of Analyzer per non-terminal, switching on
+# the lookahead to pick a production and then matching its terminals,
+# descending into its non-terminals and calling its rules in order.
+#
+# Non-terminals listed in HAND_WRITTEN get no function, Analyzer defines
+# their _descend_ functions itself.
+#
+#   cmake -DPRODUCTIONS=<csv> -DSYNTACTIC_TABLE=<csv> -DOUTPUT=<header>
+#         [-DHAND_WRITTEN=<non-terminals>] -P generate_descent_parser.cmake
+
+cmake_minimum_required(VERSION 3.5)
+
+file(STRINGS ${PRODUCTIONS} production_lines)
+file(STRINGS ${SYNTACTIC_TABLE} table_lines)
+
+set(production 0)
+foreach (line IN LISTS production_lines)
+    string(REPLACE "," ";" cells "${line}")
+    list(GET cells 0 head_${production})
+    list(REMOVE_AT cells 0)
+    list(REMOVE_ITEM cells "")
+    set(items_${production} ${cells})
+    math(EXPR production "${production} + 1")
+endforeach ()
+
+list(GET table_lines 0 header)
+string(REPLACE "," ";" terminals "${header}")
+list(REMOVE_AT terminals 0)
+list(REMOVE_AT table_lines 0)
+
+set(functions "")
+foreach (line IN LISTS table_lines)
+    string(REPLACE "," ";" cells "${line}")
+    list(GET cells 0 non_terminal)
+    list(REMOVE_AT cells 0)
+    list(FIND HAND_WRITTEN ${non_terminal} hand_written)
+    if (NOT hand_written EQUAL -1)
+        continue()
+    endif ()
+
+    # Groups the lookahead tokens by the production they select, keeping
+    # the productions in the order they first show up.
+    set(selected "")
+    set(column 0)
+    foreach (cell IN LISTS cells)
+        if (NOT cell STREQUAL "")
+            math(EXPR production "${cell} - 1")
+            list(GET terminals ${column} token)
+            list(FIND selected ${production} found)
+            if (found EQUAL -1)
+                list(APPEND selected ${production})
+                set(tokens_${production} "")
+            endif ()
+            list(APPEND tokens_${production} ${token})
+        endif ()
+        math(EXPR column "${column} + 1")
+    endforeach ()
+
+    # A production ending in the non-terminal itself loops instead of
+    # recursing, so that long lists do not grow the native stack.
+    set(loops FALSE)
+    foreach (production IN LISTS selected)
+        set(items ${items_${production}})
+        list(LENGTH items length)
+        if (length GREATER 0)
+            list(GET items -1 last)
+            if (last STREQUAL non_terminal)
+                set(loops TRUE)
+            endif ()
+        endif ()
+    endforeach ()
+
+    if (loops)
+        set(indent "            ")
+        string(APPEND functions "void _descend_${non_terminal}() {\n"
+                "    std::size_t tail_base = tail_productions.size();\n"
+                "    while (true) {\n"
+                "        switch (_lookahead()) {\n")
+    else ()
+        set(indent "        ")
+        string(APPEND functions "void _descend_${non_terminal}() {\n"
+                "    switch (_lookahead()) {\n")
+    endif ()
+
+    foreach (production IN LISTS selected)
+        set(items ${items_${production}})
+        foreach (token IN LISTS tokens_${production})
+            string(APPEND functions "${indent}case Token::${token}:\n")
+        endforeach ()
+        list(LENGTH items length)
+        if (length GREATER 0)
+            string(REPLACE ";" " " text "${items}")
+            string(APPEND functions "${indent}    // ${head_${production}} -> ${text}\n")
+        else ()
+            string(APPEND functions "${indent}    // ${head_${production}}\n")
+        endif ()
+
+        set(symbol_count 0)
+        foreach (item IN LISTS items)
+            if (NOT item MATCHES "^[0-9]+$")
+                math(EXPR symbol_count "${symbol_count} + 1")
+            endif ()
+        endforeach ()
+        string(APPEND functions "${indent}    _expand(${production});\n")
+
+        set(tail FALSE)
+        if (length GREATER 0)
+            list(GET items -1 last)
+            if (last STREQUAL non_terminal)
+                set(tail TRUE)
+                list(REMOVE_AT items -1)
+            endif ()
+        endif ()
+
+        foreach (item IN LISTS items)
+            if (item MATCHES "^[0-9]+$")
+                string(APPEND functions "${indent}    _apply_rule(${item});\n")
+            else ()
+                list(FIND terminals ${item} terminal)
+                if (terminal EQUAL -1)
+                    string(APPEND functions "${indent}    _descend_${item}();\n")
+                else ()
+                    string(APPEND functions "${indent}    _match(Token::${item});\n")
+                endif ()
+            endif ()
+        endforeach ()
+
+        if (tail)
+            string(APPEND functions "${indent}    tail_productions.push_back(${production});\n"
+                    "${indent}    continue;\n")
+        else ()
+            if (symbol_count GREATER 0)
+                string(APPEND functions "${indent}    _finish(${production});\n")
+            endif ()
+            if (loops)
+                string(APPEND functions "${indent}    _finish_tail(tail_base);\n")
+            endif ()
+            string(APPEND functions "${indent}    return;\n")
+        endif ()
+    endforeach ()
+
+    string(APPEND functions "${indent}default:\n"
+            "${indent}    throw SyntaxError(_descriptor());\n")
+    if (loops)
+        string(APPEND functions "        }\n    }\n}\n\n")
+    else ()
+        string(APPEND functions "    }\n}\n\n")
+    endif ()
+endforeach ()
+
+file(WRITE ${OUTPUT}.tmp
+"// Generated by generate_descent_parser.cmake from productions.csv and syntactic_table.csv; do not edit.
+
+${functions}")
+# Leaves the header alone when nothing changed, so nothing gets rebuilt.
+configure_file(${OUTPUT}.tmp ${OUTPUT} COPYONLY)
+file(REMOVE ${OUTPUT}.tmp)
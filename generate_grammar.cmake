@@ -0,0 +1,105 @@
+# Turns productions.csv and syntactic_table.csv into constexpr tables, so
+# that the analyzer needs neither the files nor any parsing at run time.
+#
+#   cmake -DPRODUCTIONS=<csv> -DSYNTACTIC_TABLE=<csv> -DOUTPUT=<header> -P generate_grammar.cmake
+
+cmake_minimum_required(VERSION 3.5)
+
+file(STRINGS ${PRODUCTIONS} production_lines)
+file(STRINGS ${SYNTACTIC_TABLE} table_lines)
+
+# Each production is stored the way it lands on the parse stack: its end
+# marker, then its items last to first. The grammar symbols among them are
+# listed separately, in the same order, for their attribute slots.
+set(items "")
+set(item_starts "")
+set(symbols "")
+set(symbol_starts "")
+set(item_count 0)
+set(symbol_count 0)
+set(production 0)
+foreach (line IN LISTS production_lines)
+    string(REPLACE "," ";" cells "${line}")
+    list(REMOVE_AT cells 0)
+    list(REVERSE cells)
+    string(APPEND item_starts "        ${item_count},\n")
+    string(APPEND symbol_starts "        ${symbol_count},\n")
+    string(APPEND items "        {${production}, ProductionItem::PRODUCTION_END},\n")
+    math(EXPR item_count "${item_count} + 1")
+    foreach (cell IN LISTS cells)
+        if (cell MATCHES "^[0-9]+$")
+            string(APPEND items "        {${cell}, ProductionItem::RULE},\n")
+        elseif (NOT cell STREQUAL "")
+            string(APPEND items "        {SyntaxSymbol::${cell}},\n")
+            string(APPEND symbols "        SyntaxSymbol::${cell},\n")
+            math(EXPR symbol_count "${symbol_count} + 1")
+        else ()
+            continue()
+        endif ()
+        math(EXPR item_count "${item_count} + 1")
+    endforeach ()
+    math(EXPR production "${production} + 1")
+endforeach ()
+string(APPEND item_starts "        ${item_count},\n")
+string(APPEND symbol_starts "        ${symbol_count},\n")
+list(LENGTH production_lines production_count)
+
+# The header names the tokens of each column.
+list(GET table_lines 0 header)
+string(REPLACE "," ";" columns "${header}")
+list(REMOVE_AT columns 0)
+list(REMOVE_AT table_lines 0)
+
+get_filename_component(table_name ${SYNTACTIC_TABLE} NAME)
+set(entries "")
+set(checks "")
+set(row 0)
+foreach (line IN LISTS table_lines)
+    string(REPLACE "," ";" cells "${line}")
+    list(GET cells 0 non_terminal)
+    list(REMOVE_AT cells 0)
+    string(APPEND checks "static_assert(SyntaxSymbol::${non_terminal} == SyntaxSymbol::PACKAGE + ${row}, "
+            "\"${non_terminal} is out of order in ${table_name}\");\n")
+    set(column 0)
+    foreach (cell IN LISTS cells)
+        if (NOT cell STREQUAL "")
+            list(GET columns ${column} token)
+            math(EXPR production "${cell} - 1")
+            if (NOT production LESS production_count)
+                message(FATAL_ERROR "${table_name}: no production ${cell} for ${non_terminal}, ${token}")
+            endif ()
+            string(APPEND entries "        {SyntaxSymbol::${non_terminal}, Token::${token}, ${production}},\n")
+        endif ()
+        math(EXPR column "${column} + 1")
+    endforeach ()
+    math(EXPR row "${row} + 1")
+endforeach ()
+
+file(WRITE ${OUTPUT}.tmp
+"// Generated by generate_grammar.cmake from productions.csv and syntactic_table.csv; do not edit.
+
+${checks}
+constexpr int NUM_OF_PRODUCTIONS = ${production_count};
+constexpr int NUM_OF_NON_TERMINALS = ${row};
+
+// Production p is pushed as expansion_items[expansion_starts[p]] up to
+// expansion_items[expansion_starts[p + 1]], and the slots of its symbols as
+// expansion_symbols[symbol_starts[p]] up to expansion_symbols[symbol_starts[p + 1]].
+constexpr ProductionItem expansion_items[] = {
+${items}};
+
+constexpr int expansion_starts[] = {
+${item_starts}};
+
+constexpr int expansion_symbols[] = {
+${symbols}};
+
+constexpr int symbol_starts[] = {
+${symbol_starts}};
+
+constexpr SyntacticTableEntry syntactic_table_entries[] = {
+${entries}};
+")
+# Leaves the header alone when nothing changed, so nothing gets rebuilt.
+configure_file(${OUTPUT}.tmp ${OUTPUT} COPYONLY)
+file(REMOVE ${OUTPUT}.tmp)
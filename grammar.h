@@ -0,0 +1,199 @@
+#ifndef ALGO_GRAMMAR_H
+#define ALGO_GRAMMAR_H
+
+#include <array>
+#include <cstdint>
+
+#include "definitions.h"
+
+
+// Item of a production, and of the parse stack, packed into 32 bits: the
+// type in the low two and the symbol, rule or production id above them.
+class ProductionItem {
+public:
+    enum Type {
+        SYMBOL,
+        RULE,
+        PRODUCTION_END,
+        // A step of the expression parser; the value is an ExpressionStep.
+        EXPRESSION
+    };
+
+    enum ExpressionStep {
+        OPERAND,
+        AFTER_TERM,
+        AFTER_UNARY_TERM,
+        EXPRESSION_END
+    };
+
+    ProductionItem() = default;
+
+    constexpr ProductionItem(int value, Type type=SYMBOL) : bits((std::uint32_t)value << 2 | type) { }
+
+    constexpr int value() const {
+        return (int)(bits >> 2);
+    }
+
+    constexpr Type type() const {
+        return (Type)(bits & 3);
+    }
+
+private:
+    std::uint32_t bits;
+};
+
+
+// The production to expand non_terminal with when token is next.
+struct SyntacticTableEntry {
+    int non_terminal;
+    int token;
+    int production;
+};
+
+
+// The grammar, compiled in from the CSV files at build time.
+namespace grammar {
+
+#include "grammar_tables.h"
+
+// Entry of parse_table without a production.
+constexpr std::int16_t NO_PRODUCTION = -1;
+
+// One column per token, including ERROR, which has no productions.
+typedef std::array<std::array<std::int16_t, Token::ERROR + 1>, NUM_OF_NON_TERMINALS> ParseTable;
+
+constexpr ParseTable make_parse_table() {
+    ParseTable table{};
+    for (auto &row : table)
+        for (auto &production : row)
+            production = NO_PRODUCTION;
+    for (const auto &entry : syntactic_table_entries)
+        table[entry.non_terminal - SyntaxSymbol::PACKAGE][entry.token] = (std::int16_t)entry.production;
+    return table;
+}
+
+// Production of non-terminal (row, from PACKAGE on) when token is next.
+constexpr ParseTable parse_table = make_parse_table();
+
+
+constexpr int NUM_OF_EXPANSION_SYMBOLS = symbol_starts[NUM_OF_PRODUCTIONS];
+
+constexpr std::array<ProductionItem, NUM_OF_EXPANSION_SYMBOLS> make_symbol_items() {
+    std::array<ProductionItem, NUM_OF_EXPANSION_SYMBOLS> items{};
+    for (int i = 0; i < NUM_OF_EXPANSION_SYMBOLS; ++i)
+        items[i] = ProductionItem(expansion_symbols[i]);
+    return items;
+}
+
+// The productions as a plain recognizer pushes them, without rules or end
+// markers: symbol_items[symbol_starts[p]] up to symbol_items[symbol_starts[p + 1]].
+constexpr auto symbol_items = make_symbol_items();
+
+
+// Set of tokens, for the FIRST and FOLLOW sets of the grammar.
+class TokenSet {
+public:
+    constexpr TokenSet() : words{0, 0} { }
+
+    constexpr bool contains(int token) const {
+        return words[token >> 6] >> (token & 63) & 1;
+    }
+
+    constexpr void insert(int token) {
+        words[token >> 6] |= (std::uint64_t)1 << (token & 63);
+    }
+
+    // Returns whether anything was added.
+    constexpr bool merge(const TokenSet &other) {
+        bool added = false;
+        for (int i = 0; i < 2; ++i) {
+            added = added or (other.words[i] & ~words[i]);
+            words[i] |= other.words[i];
+        }
+        return added;
+    }
+
+private:
+    static_assert(Token::ERROR < 128, "TokenSet holds 128 tokens");
+
+    std::uint64_t words[2];
+};
+
+typedef std::array<TokenSet, NUM_OF_NON_TERMINALS> TokenSets;
+
+// The productions are shared between non-terminals, and the empty one
+// between all of them, so their heads come from the parse table.
+constexpr TokenSets make_follow_sets() {
+    // Whether each non-terminal expands with each production.
+    std::array<std::array<bool, NUM_OF_PRODUCTIONS>, NUM_OF_NON_TERMINALS> heads{};
+    std::array<bool, NUM_OF_NON_TERMINALS> nullable{};
+    for (const auto &entry : syntactic_table_entries)
+        heads[entry.non_terminal - SyntaxSymbol::PACKAGE][entry.production] = true;
+
+    // Symbols are listed last to first, which suits both passes: FIRST of a
+    // production stops at its first non-nullable symbol, and FOLLOW of each
+    // symbol is built from what comes after it.
+    TokenSets first{};
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int head = 0; head < NUM_OF_NON_TERMINALS; ++head) {
+            for (int production = 0; production < NUM_OF_PRODUCTIONS; ++production) {
+                if (not heads[head][production])
+                    continue;
+                bool empty = true;
+                for (int i = symbol_starts[production + 1] - 1; empty and i >= symbol_starts[production]; --i) {
+                    int symbol = expansion_symbols[i];
+                    if (symbol < SyntaxSymbol::PACKAGE) {
+                        if (not first[head].contains(symbol)) {
+                            first[head].insert(symbol);
+                            changed = true;
+                        }
+                        empty = false;
+                    } else {
+                        changed = first[head].merge(first[symbol - SyntaxSymbol::PACKAGE]) or changed;
+                        empty = nullable[symbol - SyntaxSymbol::PACKAGE];
+                    }
+                }
+                if (empty and not nullable[head]) {
+                    nullable[head] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    TokenSets follow{};
+    follow[0].insert(Token::NONE);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int head = 0; head < NUM_OF_NON_TERMINALS; ++head) {
+            for (int production = 0; production < NUM_OF_PRODUCTIONS; ++production) {
+                if (not heads[head][production])
+                    continue;
+                TokenSet after = follow[head];
+                for (int i = symbol_starts[production]; i < symbol_starts[production + 1]; ++i) {
+                    int symbol = expansion_symbols[i];
+                    if (symbol < SyntaxSymbol::PACKAGE) {
+                        after = TokenSet();
+                        after.insert(symbol);
+                    } else {
+                        int row = symbol - SyntaxSymbol::PACKAGE;
+                        changed = follow[row].merge(after) or changed;
+                        if (not nullable[row])
+                            after = TokenSet();
+                        after.merge(first[row]);
+                    }
+                }
+            }
+        }
+    }
+    return follow;
+}
+
+// Tokens that may come after each non-terminal (row, from PACKAGE on),
+// which error recovery synchronizes on.
+constexpr TokenSets follow_sets = make_follow_sets();
+
+}
+
+#endif //ALGO_GRAMMAR_H
@@ -0,0 +1,60 @@
+#include "interner.h"
+
+
+Interner::Interner() : count(0), slots(1024, 0) {
+    intern(std::string_view());
+}
+
+
+Interner::~Interner() { }
+
+
+std::uint32_t Interner::intern(std::string_view name) {
+    std::uint32_t hash = _hash(name);
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask; slots[i]; i = (i + 1) & mask) {
+        std::uint32_t id = slots[i] - 1;
+        if (hashes[id] == hash and get_name(id) == name)
+            return id;
+    }
+
+    std::uint32_t id = (std::uint32_t)count;
+    std::uint32_t index = id + FIRST_BLOCK;
+    int block = 31 - __builtin_clz(index);
+    if (index == 1u << block)
+        blocks[block - FIRST_BLOCK_BITS].reset(new std::string_view[index]);
+    blocks[block - FIRST_BLOCK_BITS][index - (1u << block)] = name;
+    ++count;
+    hashes.push_back(hash);
+    // Kept at most half full.
+    if (count * 2 > slots.size()) {
+        _grow();
+    } else {
+        std::size_t i = hash & mask;
+        while (slots[i])
+            i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+    return id;
+}
+
+
+std::uint32_t Interner::_hash(std::string_view name) {
+    // FNV-1a.
+    std::uint32_t hash = 2166136261u;
+    for (char c : name)
+        hash = (hash ^ (unsigned char)c) * 16777619u;
+    return hash;
+}
+
+
+void Interner::_grow() {
+    slots.assign(slots.size() * 2, 0);
+    std::size_t mask = slots.size() - 1;
+    for (std::uint32_t id = 0; id < count; ++id) {
+        std::size_t i = hashes[id] & mask;
+        while (slots[i])
+            i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef ALGO_INTERNER_H
+#define ALGO_INTERNER_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+// Gives every distinct name a dense id, in order of first appearance. Names
+// are not copied, so they must outlive the interner; the lexer only interns
+// slices of the source code. Id 0 is always the empty name, which no lexeme
+// has; it stands for identifiers that error recovery takes as there.
+//
+// Names are kept in blocks that never move, so another thread may look up
+// the names of ids it was handed, through some synchronization, while
+// interning goes on.
+class Interner {
+public:
+    explicit Interner();
+
+    virtual ~Interner();
+
+    static constexpr std::uint32_t EMPTY_NAME = 0;
+
+    std::uint32_t intern(std::string_view name);
+
+    std::string_view get_name(std::uint32_t id) const {
+        // Block b holds FIRST_BLOCK << b names, from id (FIRST_BLOCK << b) - FIRST_BLOCK on.
+        std::uint32_t index = id + FIRST_BLOCK;
+        int block = 31 - __builtin_clz(index);
+        return blocks[block - FIRST_BLOCK_BITS][index - (1u << block)];
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+private:
+    static constexpr int FIRST_BLOCK_BITS = 6;
+    static constexpr std::uint32_t FIRST_BLOCK = 1u << FIRST_BLOCK_BITS;
+
+    static std::uint32_t _hash(std::string_view name);
+
+    void _grow();
+
+    std::unique_ptr<std::string_view[]> blocks[32 - FIRST_BLOCK_BITS];
+    std::size_t count;
+    std::vector<std::uint32_t> hashes;
+    // Open addressing with linear probing; slots hold id + 1, 0 when empty.
+    std::vector<std::uint32_t> slots;
+};
+
+#endif //ALGO_INTERNER_H
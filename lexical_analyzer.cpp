@@ -1,353 +1,9 @@
 #include "lexical_analyzer.h"
-
-LexicalAnalyzer::LexicalAnalyzer(SourceCode *source_code) :
-        source_code(source_code), line_no(1) {
-    finished = not source_code->get(curr_char);
-}
-
-
-LexicalAnalyzer::~LexicalAnalyzer() { }
-
-
-LexicalDescriptor LexicalAnalyzer::next() {
-    while (not finished and _is_white_space(curr_char)) {
-        if (curr_char == '\n')
-            line_no++;
-        next_char();
-    }
-    if (finished)
-        return {};
-
-    curr_lexeme = std::string(1, curr_char);
-
-    auto single_char = single_char_token.find(curr_char);
-
-    if (single_char != single_char_token.end()) {
-        next_char();
-        return {single_char->second, curr_lexeme, line_no};
-    } else if (_is_alpha(curr_char)) {
-        return _identifier();
-    } else if (_is_decimal(curr_char)) {
-        return _number(false);
-    } else if (curr_char == '\'') {
-        return _rune();
-    } else if (curr_char == '"') {
-        return _string();
-    } else if (curr_char == '`') {
-        return _raw_string();
-    } else if (curr_char == '.') {
-        next_char();
-        if (finished or not _is_decimal(curr_char))
-            return {Token::DOT, curr_lexeme, line_no};
-        else {
-            curr_lexeme.push_back(curr_char);
-            return _number(true);
-        }
-    } /*else if (curr_char == ':') {
-        next_char();
-        if (finished or curr_char != '=')
-            throw LexicalError(curr_lexeme, line_no);
-        curr_lexeme.push_back(curr_char);
-        next_char();
-        return {Token::DECL_ASSIGN, curr_lexeme, line_no};
-    } */else if (operator_start.find(curr_char) != operator_start.end()) {
-        return _operator();
-    }
-    else {
-        throw LexicalError(curr_lexeme, line_no);
-    }
-}
-
-
-void LexicalAnalyzer::next_char() {
-    finished = not source_code->get(curr_char);
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_identifier() {
-    next_char();
-    while (not finished and _is_alpha_num(curr_char)) {
-        curr_lexeme.push_back(curr_char);
-        next_char();
-    }
-    auto reserved_word = reserved_words.find(curr_lexeme);
-    if (reserved_word != reserved_words.end())
-        return LexicalDescriptor(reserved_word->second, curr_lexeme, line_no);
-    return {Token::IDENT, curr_lexeme, line_no};
-}
-
-LexicalDescriptor LexicalAnalyzer::_rune() {
-    next_char();
-    if (finished or not _is_printable(curr_char))
-        throw LexicalError(curr_lexeme, line_no);
-    curr_lexeme.push_back(curr_char);
-    if (curr_char == '\\') {
-        next_char();
-        if (finished)
-            throw LexicalError(curr_lexeme, line_no);
-        curr_lexeme.push_back(curr_char);
-        if (not std::binary_search(escaped_chars.begin(), escaped_chars.end(), curr_char))
-            throw LexicalError(curr_lexeme, line_no);
-    }
-    next_char();
-    if (finished or curr_char != '\'')
-        throw LexicalError(curr_lexeme, line_no);
-    curr_lexeme.push_back(curr_char);
-    next_char();
-    return {Token::RUNE, curr_lexeme, line_no};
-}
-
-LexicalDescriptor LexicalAnalyzer::_string() {
-    next_char();
-    while (not finished and _is_printable(curr_char) and curr_char != '"') {
-        curr_lexeme.push_back(curr_char);
-        if (curr_char == '\\') {
-            next_char();
-            if (finished)
-                throw LexicalError(curr_lexeme, line_no);
-            curr_lexeme.push_back(curr_char);
-            if (not std::binary_search(escaped_chars.begin(), escaped_chars.end(), curr_char))
-                throw LexicalError(curr_lexeme, line_no);
-        }
-        next_char();
-    }
-    if (finished or curr_char != '"')
-        throw LexicalError(curr_lexeme, line_no);
-    curr_lexeme.push_back(curr_char);
-    next_char();
-    return {Token::STRING, curr_lexeme, line_no};
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_raw_string() {
-    next_char();
-    while (not finished and curr_char != '`') {
-        if (curr_char == '\n')
-            ++line_no;
-        curr_lexeme.push_back(curr_char);
-        next_char();
-    }
-    if (finished or curr_char != '`')
-        throw LexicalError(curr_lexeme, line_no);
-    curr_lexeme.push_back(curr_char);
-    next_char();
-    return {Token::R_STRING, curr_lexeme, line_no};
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_number(bool dot_start) {
-    bool dot = dot_start, exp_part = false;
-    if (not dot_start) {
-        if (curr_char == '0') {
-            next_char();
-            if (not finished and (curr_char == 'x' or curr_char == 'X')) {
-                curr_lexeme.push_back(curr_char);
-                next_char();
-                while (not finished and _is_hexadecimal(curr_char)) {
-                    curr_lexeme.push_back(curr_char);
-                    next_char();
-                }
-                if (curr_lexeme.size() == 2)
-                    throw LexicalError(curr_lexeme, line_no);
-                return {Token::HEXADEC, curr_lexeme, line_no};
-            }
-        } else {
-            next_char();
-        }
-        while (not finished and _is_decimal(curr_char)) {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-        }
-
-        if (not finished and curr_char == '.') {
-            dot = true;
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            while (not finished and _is_decimal(curr_char)) {
-                curr_lexeme.push_back(curr_char);
-                next_char();
-            }
-        }
-    } else {
-        while (not finished and _is_decimal(curr_char)) {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-        }
-    }
-
-    if (not finished and (curr_char == 'e' or curr_char == 'E')) {
-        exp_part = true;
-        curr_lexeme.push_back(curr_char);
-        next_char();
-        if (finished or _is_white_space(curr_char))
-            throw LexicalError(curr_lexeme, line_no);
-        curr_lexeme.push_back(curr_char);
-        if (curr_char == '+' or curr_char == '-')
-            next_char();
-        bool seen_number = false;
-        while (not finished and _is_decimal(curr_char)) {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            seen_number = true;
-        }
-        if (not seen_number)
-            throw LexicalError(curr_lexeme, line_no);
-    }
-
-    bool extra_characters = false;
-    while (not finished and (_is_alpha_num(curr_char) or curr_char == '.')) {
-        curr_lexeme.push_back(curr_char);
-        extra_characters = true;
-        next_char();
-    }
-    if (extra_characters)
-        throw LexicalError(curr_lexeme, line_no);
-
-    if (not dot and not exp_part) {
-        if (curr_lexeme[0] == '0') {
-            for (char c : curr_lexeme)
-                if (not _is_octal(c))
-                    throw LexicalError(curr_lexeme, line_no);
-            return {Token::OCTAL, curr_lexeme, line_no};
-        }
-        return {Token::DEC, curr_lexeme, line_no};
-    }
-
-    return {Token::FLOAT, curr_lexeme, line_no};
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_operator() {
-    next_char();
-    if (not finished) {
-        if (curr_lexeme[0] == '/') {
-            if (curr_char == '/') {
-                return _line_comment();
-            }
-            if (curr_char == '*') {
-                curr_lexeme.push_back(curr_char);
-                return _block_comment();
-            }
-        }
-        if (curr_lexeme[0] == '+' and curr_char == '+') {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            return {Token::INCR, curr_lexeme, line_no};
-        }
-        if (curr_lexeme[0] == '-' and curr_char == '-') {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            return {Token::DECR, curr_lexeme, line_no};
-        }
-        if (curr_lexeme[0] == '&' and curr_char == '&') {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            return {Token::AND, curr_lexeme, line_no};
-        }
-        if (curr_lexeme[0] == '|' and curr_char == '|') {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            return {Token::OR, curr_lexeme, line_no};
-        }
-        if ((curr_lexeme[0] == '<' or curr_lexeme[0] == '>') and curr_char == curr_lexeme[0]) {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            if (not finished and curr_char == '=') {
-                curr_lexeme.push_back(curr_char);
-                next_char();
-                return {curr_lexeme[0] == '<' ? Token::A_L_SHIFT : Token::A_R_SHIFT, curr_lexeme, line_no};
-            }
-            return {curr_lexeme[0] == '<' ? Token::L_SHIFT : Token::R_SHIFT, curr_lexeme, line_no};
-        }
-        if (curr_lexeme[0] == '&' and curr_char == '^') {
-            curr_lexeme.push_back(curr_char);
-            next_char();
-            if (not finished and curr_char == '=') {
-                curr_lexeme.push_back(curr_char);
-                next_char();
-                return {Token::A_BW_AND_NOT, curr_lexeme, line_no};
-            }
-            return {Token::BW_AND_NOT, curr_lexeme, line_no};
-        }
-    }
-    if (curr_char == '=') {
-        curr_lexeme.push_back(curr_char);
-        next_char();
-        return {operator_equal.find(curr_lexeme[0])->second, curr_lexeme, line_no};
-    }
-    return {operator_start.find(curr_lexeme[0])->second, curr_lexeme, line_no};
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_line_comment() {
-    next_char();
-    while (not finished and curr_char != '\n')
-        next_char();
-    return next();
-}
-
-
-LexicalDescriptor LexicalAnalyzer::_block_comment() {
-    next_char();
-    bool star = false;
-    while (not finished) {
-        if (star and curr_char == '/') {
-            next_char();
-            return next();
-        }
-        star = curr_char == '*';
-        curr_lexeme.push_back(curr_char);
-        if (curr_char == '\n')
-            ++line_no;
-        next_char();
-    }
-    throw LexicalError(curr_lexeme, line_no);
-}
-
-
-bool LexicalAnalyzer::_is_decimal(char c) {
-    return c >= '0' and c <= '9';
-}
+#include "lexical_automaton.h"
+#include "perfect_hash.h"
 
 
-bool LexicalAnalyzer::_is_octal(char c) {
-    return c >= '0' and c < '8';
-}
-
-
-bool LexicalAnalyzer::_is_hexadecimal(char c) {
-    return (c >= '0' and c < '9') or
-           (c >= 'a' and c <= 'f') or
-           (c >= 'A' and c <= 'F');
-}
-
-
-bool LexicalAnalyzer::_is_alpha(char c) {
-    return (c >= 'A' and c <= 'Z') or
-           (c >= 'a' and c <= 'z') or
-           c == '_';
-}
-
-
-bool LexicalAnalyzer::_is_alpha_num(char c) {
-    return _is_decimal(c) or _is_alpha(c);
-}
-
-
-bool LexicalAnalyzer::_is_white_space(char c) {
-    return c == ' ' or c == '\t' or c == '\t' or c == '\n';
-}
-
-
-bool LexicalAnalyzer::_is_printable(char c) {
-    return c >= 32 and c <= 126;
-}
-
-
-const std::vector<char> LexicalAnalyzer::escaped_chars = {'"', '\'', '\\', 'n', 't'};
-
-
-const std::map<std::string, Token> LexicalAnalyzer::reserved_words = {
+constexpr PerfectHash<16, 64>::Entry reserved_word_entries[] = {
         {"const",    Token::CONST},
         {"var",      Token::VAR},
         {"for",      Token::FOR},
@@ -374,57 +30,119 @@ const std::map<std::string, Token> LexicalAnalyzer::reserved_words = {
         {"string",   Token::STR}
 };
 
+constexpr auto reserved_words = PerfectHash<16, 64>::build(reserved_word_entries);
+static_assert(reserved_words.is_complete(), "reserved words need a different hash");
 
-const std::map<char, Token> LexicalAnalyzer::single_char_token = {
-        {',', Token::COL},
-        {';', Token::SEMICOL},
-        {'(', Token::O_PAREN},
-        {')', Token::C_PAREN},
-        {'{', Token::O_BRACK},
-        {'}', Token::C_BRACK},
-        {'[', Token::O_SQBRACK},
-        {']', Token::C_SQBRACK}
-};
+
+LexicalAnalyzer::LexicalAnalyzer(SourceCode *source_code, Interner *interner) :
+        source_code(source_code), interner(interner), kernels(scan_kernels()), line_no(1),
+        position(source_code->begin()), end(source_code->end()), lexeme_start(position) {
+}
 
 
-const std::map<char, Token> LexicalAnalyzer::operator_start = {
-        {'!', Token::NOT},
-        {'%', Token::MOD},
-        {'&', Token::BW_AND},
-        {'*', Token::TIMES},
-        {'+', Token::PLUS},
-        {'-', Token::MINUS},
-        {'/', Token::DIV},
-        {'<', Token::LT},
-        {'=', Token::ASSIGN},
-        {'>', Token::GT},
-        {'^', Token::BW_XOR_NEG},
-        {'|', Token::BW_OR}
-};
+LexicalAnalyzer::LexicalAnalyzer(SourceCode *source_code, Interner *interner, const char *start) :
+        source_code(source_code), interner(interner), kernels(scan_kernels()), line_no(1),
+        position(start), end(source_code->end()), lexeme_start(position) {
+}
 
 
-const std::map<char, Token> LexicalAnalyzer::operator_equal = {
-        {'!', Token::NEQ},
-        {'%', Token::A_MOD},
-        {'&', Token::A_BW_AND},
-        {'*', Token::A_TIMES},
-        {'+', Token::A_PLUS},
-        {'-', Token::A_MINUS},
-        {'/', Token::A_DIV},
-        {'<', Token::LTE},
-        {'=', Token::EQ},
-        {'>', Token::GTE},
-        {'^', Token::A_BW_XOR},
-        {'|', Token::A_BW_OR}
-};
+LexicalAnalyzer::~LexicalAnalyzer() { }
+
+
+LexicalDescriptor LexicalAnalyzer::next() {
+    const auto &char_class = lexical_tables.char_class;
+    const auto &transition = lexical_tables.transition;
+
+    while (true) {
+        std::size_t newlines = 0;
+        position = kernels.skip_white_space(position, end, newlines);
+        line_no += newlines;
+        lexeme_start = position;
+        if (position == end)
+            return {Token::NONE, _lexeme(), line_no};
+
+        std::uint8_t state = LexicalAutomaton::START;
+        while (position != end) {
+            std::uint8_t next_state = transition[state][char_class[(unsigned char)*position]];
+            if (next_state == LexicalAutomaton::STOP)
+                break;
+            ++position;
+            if (next_state != state) {
+                state = next_state;
+                _skip_run(lexical_tables.run[state]);
+            }
+        }
 
+        if (lexical_tables.multi_line[state])
+            line_no += kernels.count_newlines(lexeme_start, position);
 
-LexicalError::LexicalError(const std::string &lexeme, std::size_t line_no) :
-        lexeme(lexeme), line_no(line_no) {
-    std::stringstream ss;
-    ss << "Unknown lexeme \"" << lexeme << "\"" << "at line " << line_no << ".";
-    msg = ss.str();
+        switch (lexical_tables.action[state]) {
+            case LexicalAutomaton::ACCEPT: {
+                if (state == LexicalAutomaton::IDENTIFIER) {
+                    Token token = reserved_words.find(_lexeme(), Token::IDENT);
+                    if (token == Token::IDENT)
+                        return {token, _lexeme(), line_no, interner->intern(_lexeme())};
+                    return {token, _lexeme(), line_no};
+                } else if (state == LexicalAutomaton::SINGLE_CHAR) {
+                    return {lexical_tables.single_char_token[(unsigned char)*lexeme_start], _lexeme(), line_no};
+                }
+                Token token = lexical_tables.token[state];
+                if (token.is_literal())
+                    return {token, _lexeme(), line_no, decode_literal(token, _lexeme(), decoded_strings)};
+                return {token, _lexeme(), line_no};
+            }
+            case LexicalAutomaton::REJECT_NEXT:
+                // The offending character is shown but lexed again.
+                if (position != end)
+                    return {Token::ERROR, {lexeme_start, std::size_t(position - lexeme_start + 1)}, line_no};
+                [[fallthrough]];
+            case LexicalAutomaton::REJECT:
+                return {Token::ERROR, _lexeme(), line_no};
+            default: /* LexicalAutomaton::SKIP */
+                break;
+        }
+    }
+}
+
+
+void LexicalAnalyzer::_skip_run(std::uint8_t run) {
+    switch (run) {
+        case LexicalAutomaton::NO_RUN:
+            break;
+        case LexicalAutomaton::IDENTIFIER_RUN:
+            position = kernels.identifier_end(position, end);
+            break;
+        case LexicalAutomaton::DIGITS_RUN:
+            position = kernels.digits_end(position, end);
+            break;
+        case LexicalAutomaton::STRING_RUN:
+            position = kernels.string_body_end(position, end);
+            break;
+        case LexicalAutomaton::RAW_STRING_RUN:
+            position = kernels.find_char(position, end, '`');
+            break;
+        case LexicalAutomaton::LINE_COMMENT_RUN:
+            position = kernels.find_char(position, end, '\n');
+            break;
+        case LexicalAutomaton::BLOCK_COMMENT_RUN:
+            position = kernels.find_char(position, end, '*');
+            break;
+    }
 }
 
 
+std::string_view LexicalAnalyzer::_lexeme() const {
+    return std::string_view(lexeme_start, position - lexeme_start);
+}
+
+
+LexicalError::LexicalError(const LexicalDescriptor &descriptor) :
+        lexeme(descriptor.get_lexeme()), line_no(descriptor.get_line_no()) { }
+
+
 LexicalError::~LexicalError() { }
+
+
+std::ostream &operator<<(std::ostream &out, const LexicalError &err) {
+    return out << err.get_diagnostic();
+}
@@ -1,80 +1,68 @@
 #ifndef ALGO_LEXICAL_ANALYZER_H
 #define ALGO_LEXICAL_ANALYZER_H
 
-#include <algorithm>
-#include <exception>
-#include <vector>
-#include <sstream>
+#include <list>
+#include <ostream>
 
+#include "diagnostics.h"
+#include "interner.h"
 #include "source_code.h"
 #include "lexical_descriptor.h"
+#include "scan_kernels.h"
 
 class LexicalAnalyzer {
 public:
-    LexicalAnalyzer(SourceCode *source_code);
+    // Identifiers are interned into interner.
+    LexicalAnalyzer(SourceCode *source_code, Interner *interner);
+
+    // Lexes from start on as if it were the beginning of the file, which
+    // makes line numbers relative to it.
+    LexicalAnalyzer(SourceCode *source_code, Interner *interner, const char *start);
 
     virtual ~LexicalAnalyzer();
 
+    // Malformed lexemes come out as Token::ERROR descriptors.
     LexicalDescriptor next();
 
-private:
-    void next_char();
-
-    LexicalDescriptor _identifier();
-
-    LexicalDescriptor _rune();
-
-    LexicalDescriptor _string();
-
-    LexicalDescriptor _raw_string();
-
-    LexicalDescriptor _number(bool dot_start);
-
-    LexicalDescriptor _operator();
-
-    LexicalDescriptor _line_comment();
-
-    LexicalDescriptor _block_comment();
-
-    bool _is_decimal(char c);
-
-    bool _is_octal(char c);
-
-    bool _is_hexadecimal(char c);
-
-    bool _is_alpha(char c);
+    Interner *get_interner() const {
+        return interner;
+    }
 
-    bool _is_alpha_num(char c);
+    void set_interner(Interner *interner) {
+        this->interner = interner;
+    }
 
-    bool _is_white_space(char c);
+    // Moves the strings decoded so far, which string literals with escape
+    // sequences point to, to the end of strings.
+    void take_decoded_strings(std::list<std::string> &strings) {
+        strings.splice(strings.end(), decoded_strings);
+    }
 
-    bool _is_printable(char c);
+private:
+    void _skip_run(std::uint8_t run);
 
-    static const std::vector<char> escaped_chars;
-    static const std::map<std::string, Token> reserved_words;
-    static const std::map<char, Token> single_char_token;
-    static const std::map<char, Token> operator_start;
-    static const std::map<char, Token> operator_equal;
+    std::string_view _lexeme() const;
 
     SourceCode *source_code;
+    Interner *interner;
+    const ScanKernels &kernels;
     std::size_t line_no;
-    char curr_char;
-    bool finished;
-    std::string curr_lexeme;
+    const char *position;
+    const char *end;
+    const char *lexeme_start;
+    std::list<std::string> decoded_strings;
 };
 
 
-class LexicalError : public std::exception {
+// Diagnostic carried by a Token::ERROR descriptor. Nothing is formatted
+// until it is written to a stream.
+class LexicalError {
 public:
-    LexicalError(const std::string &lexeme, std::size_t line_no);
+    explicit LexicalError(const LexicalDescriptor &descriptor);
 
     virtual ~LexicalError();
 
-    virtual const char *what() const throw() {
-        return msg.c_str();
-    }
-
-    const std::string &get_lexeme() const {
+    std::string_view get_lexeme() const {
         return lexeme;
     }
 
@@ -82,10 +70,16 @@ public:
         return line_no;
     }
 
+    Diagnostic get_diagnostic() const {
+        return {DiagnosticCode::UNKNOWN_LEXEME, 0, 0, (std::uint32_t)line_no, lexeme};
+    }
+
 private:
-    std::string lexeme;
+    std::string_view lexeme;
     std::size_t line_no;
-    std::string msg;
 };
 
+
+std::ostream &operator<<(std::ostream &out, const LexicalError &err);
+
 #endif //ALGO_LEXICAL_ANALYZER_H
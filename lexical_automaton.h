@@ -0,0 +1,421 @@
+#ifndef ALGO_LEXICAL_AUTOMATON_H
+#define ALGO_LEXICAL_AUTOMATON_H
+
+#include <array>
+#include <cstdint>
+
+#include "definitions.h"
+
+
+// Deterministic automaton recognizing every lexeme of the language. Each
+// byte is mapped to a character class, and the lexer follows transitions
+// until it reaches STOP; the state it stopped in then decides whether the
+// consumed characters form a token, a comment to skip or an error.
+struct LexicalAutomaton {
+    enum CharClass : std::uint8_t {
+        SPACE,
+        TAB,
+        NEW_LINE,
+        CONTROL,
+        OTHER,
+        SINGLE,
+        UNDERSCORE,
+        LETTER,
+        HEX_LETTER,
+        E_LETTER,
+        X_LETTER,
+        ESCAPE_LETTER,
+        ZERO,
+        OCTAL_DIGIT,
+        EIGHT,
+        NINE,
+        DOT,
+        QUOTE,
+        DOUBLE_QUOTE,
+        BACK_QUOTE,
+        BACKSLASH,
+        PLUS,
+        MINUS,
+        STAR,
+        SLASH,
+        PERCENT,
+        AMPERSAND,
+        PIPE,
+        CARET,
+        LESS,
+        GREATER,
+        EQUAL,
+        BANG,
+        NUM_OF_CLASSES
+    };
+
+    enum State : std::uint8_t {
+        START,
+        UNKNOWN,
+        SINGLE_CHAR,
+        IDENTIFIER,
+        DOT_START,
+        ZERO_START,
+        OCTAL_INT,
+        BAD_OCTAL_INT,
+        DECIMAL_INT,
+        HEX_START,
+        HEX_INT,
+        FRACTION,
+        EXPONENT_START,
+        EXPONENT_SIGN,
+        EXPONENT,
+        EXTRA_CHARS,
+        RUNE_OPEN,
+        RUNE_ESCAPE,
+        RUNE_CHAR,
+        RUNE_DONE,
+        STRING_BODY,
+        STRING_ESCAPE,
+        STRING_DONE,
+        RAW_STRING_BODY,
+        RAW_STRING_DONE,
+        LINE_COMMENT,
+        BLOCK_COMMENT,
+        BLOCK_COMMENT_STAR,
+        BLOCK_COMMENT_DONE,
+        OP_PLUS,
+        OP_MINUS,
+        OP_TIMES,
+        OP_DIV,
+        OP_MOD,
+        OP_BW_AND,
+        OP_BW_AND_NOT,
+        OP_BW_OR,
+        OP_BW_XOR,
+        OP_LT,
+        OP_L_SHIFT,
+        OP_GT,
+        OP_R_SHIFT,
+        OP_ASSIGN,
+        OP_NOT,
+        OP_INCR,
+        OP_DECR,
+        OP_AND,
+        OP_OR,
+        OP_A_PLUS,
+        OP_A_MINUS,
+        OP_A_TIMES,
+        OP_A_DIV,
+        OP_A_MOD,
+        OP_A_BW_AND,
+        OP_A_BW_AND_NOT,
+        OP_A_BW_OR,
+        OP_A_BW_XOR,
+        OP_A_L_SHIFT,
+        OP_A_R_SHIFT,
+        OP_LTE,
+        OP_GTE,
+        OP_EQ,
+        OP_NEQ,
+        NUM_OF_STATES,
+        STOP = 0xff
+    };
+
+    enum Action : std::uint8_t {
+        ACCEPT,
+        // The consumed characters are not a valid lexeme.
+        REJECT,
+        // Like REJECT, but the offending (unconsumed) character is part of
+        // the reported lexeme.
+        REJECT_NEXT,
+        SKIP
+    };
+
+    // Runs of characters a state loops on, which can be skipped in bulk.
+    enum Run : std::uint8_t {
+        NO_RUN,
+        IDENTIFIER_RUN,
+        DIGITS_RUN,
+        STRING_RUN,
+        RAW_STRING_RUN,
+        LINE_COMMENT_RUN,
+        BLOCK_COMMENT_RUN
+    };
+
+    struct Tables {
+        std::array<std::uint8_t, 256> char_class;
+        std::array<std::array<std::uint8_t, NUM_OF_CLASSES>, NUM_OF_STATES> transition;
+        std::array<std::uint8_t, NUM_OF_STATES> action;
+        std::array<std::uint8_t, NUM_OF_STATES> token;
+        // Whether the lexemes ending in a state may span several lines.
+        std::array<bool, NUM_OF_STATES> multi_line;
+        std::array<std::uint8_t, NUM_OF_STATES> run;
+        std::array<std::uint8_t, 256> single_char_token;
+    };
+
+    static constexpr Tables build();
+};
+
+
+constexpr LexicalAutomaton::Tables LexicalAutomaton::build() {
+    Tables tables{};
+    auto &char_class = tables.char_class;
+    auto &transition = tables.transition;
+
+    for (int c = 0; c < 256; ++c)
+        char_class[c] = c >= 32 and c <= 126 ? OTHER : CONTROL;
+    char_class[' '] = SPACE;
+    char_class['\t'] = TAB;
+    char_class['\n'] = NEW_LINE;
+    for (char c : {',', ';', '(', ')', '{', '}', '[', ']'})
+        char_class[(unsigned char)c] = SINGLE;
+    for (int c = 'a'; c <= 'z'; ++c)
+        char_class[c] = char_class[c - 'a' + 'A'] = LETTER;
+    for (char c : {'a', 'b', 'c', 'd', 'f', 'A', 'B', 'C', 'D', 'F'})
+        char_class[(unsigned char)c] = HEX_LETTER;
+    char_class['e'] = char_class['E'] = E_LETTER;
+    char_class['x'] = char_class['X'] = X_LETTER;
+    char_class['n'] = char_class['t'] = ESCAPE_LETTER;
+    char_class['_'] = UNDERSCORE;
+    char_class['0'] = ZERO;
+    for (int c = '1'; c <= '7'; ++c)
+        char_class[c] = OCTAL_DIGIT;
+    char_class['8'] = EIGHT;
+    char_class['9'] = NINE;
+    char_class['.'] = DOT;
+    char_class['\''] = QUOTE;
+    char_class['"'] = DOUBLE_QUOTE;
+    char_class['`'] = BACK_QUOTE;
+    char_class['\\'] = BACKSLASH;
+    char_class['+'] = PLUS;
+    char_class['-'] = MINUS;
+    char_class['*'] = STAR;
+    char_class['/'] = SLASH;
+    char_class['%'] = PERCENT;
+    char_class['&'] = AMPERSAND;
+    char_class['|'] = PIPE;
+    char_class['^'] = CARET;
+    char_class['<'] = LESS;
+    char_class['>'] = GREATER;
+    char_class['='] = EQUAL;
+    char_class['!'] = BANG;
+
+    tables.single_char_token[','] = Token::COL;
+    tables.single_char_token[';'] = Token::SEMICOL;
+    tables.single_char_token['('] = Token::O_PAREN;
+    tables.single_char_token[')'] = Token::C_PAREN;
+    tables.single_char_token['{'] = Token::O_BRACK;
+    tables.single_char_token['}'] = Token::C_BRACK;
+    tables.single_char_token['['] = Token::O_SQBRACK;
+    tables.single_char_token[']'] = Token::C_SQBRACK;
+
+    for (auto &row : transition)
+        for (auto &next : row)
+            next = STOP;
+
+    auto is_letter = [](int cc) {
+        return cc == UNDERSCORE or cc == LETTER or cc == HEX_LETTER or
+               cc == E_LETTER or cc == X_LETTER or cc == ESCAPE_LETTER;
+    };
+    auto is_digit = [](int cc) {
+        return cc == ZERO or cc == OCTAL_DIGIT or cc == EIGHT or cc == NINE;
+    };
+    auto is_printable = [](int cc) {
+        return cc != TAB and cc != NEW_LINE and cc != CONTROL;
+    };
+    auto is_escaped = [](int cc) {
+        return cc == DOUBLE_QUOTE or cc == QUOTE or cc == BACKSLASH or cc == ESCAPE_LETTER;
+    };
+
+    for (int cc = 0; cc < NUM_OF_CLASSES; ++cc) {
+        // Whitespace is skipped before the automaton starts.
+        transition[START][cc] = UNKNOWN;
+
+        if (is_letter(cc) or is_digit(cc))
+            transition[IDENTIFIER][cc] = IDENTIFIER;
+
+        if (is_letter(cc)) {
+            transition[ZERO_START][cc] = EXTRA_CHARS;
+            transition[OCTAL_INT][cc] = EXTRA_CHARS;
+            transition[BAD_OCTAL_INT][cc] = EXTRA_CHARS;
+            transition[DECIMAL_INT][cc] = EXTRA_CHARS;
+            transition[FRACTION][cc] = EXTRA_CHARS;
+            transition[EXPONENT][cc] = EXTRA_CHARS;
+        }
+        if (is_letter(cc) or is_digit(cc) or cc == DOT)
+            transition[EXTRA_CHARS][cc] = EXTRA_CHARS;
+        if (is_digit(cc)) {
+            transition[DOT_START][cc] = FRACTION;
+            transition[DECIMAL_INT][cc] = DECIMAL_INT;
+            transition[BAD_OCTAL_INT][cc] = BAD_OCTAL_INT;
+            transition[FRACTION][cc] = FRACTION;
+            transition[EXPONENT_START][cc] = EXPONENT;
+            transition[EXPONENT_SIGN][cc] = EXPONENT;
+            transition[EXPONENT][cc] = EXPONENT;
+        }
+        // Only '0' to '8' are taken as hexadecimal digits.
+        if ((is_digit(cc) and cc != NINE) or cc == HEX_LETTER or cc == E_LETTER) {
+            transition[HEX_START][cc] = HEX_INT;
+            transition[HEX_INT][cc] = HEX_INT;
+        }
+
+        if (is_printable(cc)) {
+            transition[RUNE_OPEN][cc] = cc == BACKSLASH ? RUNE_ESCAPE : RUNE_CHAR;
+            if (cc != DOUBLE_QUOTE)
+                transition[STRING_BODY][cc] = cc == BACKSLASH ? STRING_ESCAPE : STRING_BODY;
+        }
+        if (is_escaped(cc)) {
+            transition[RUNE_ESCAPE][cc] = RUNE_CHAR;
+            transition[STRING_ESCAPE][cc] = STRING_BODY;
+        }
+
+        if (cc != BACK_QUOTE)
+            transition[RAW_STRING_BODY][cc] = RAW_STRING_BODY;
+        if (cc != NEW_LINE)
+            transition[LINE_COMMENT][cc] = LINE_COMMENT;
+        transition[BLOCK_COMMENT][cc] = cc == STAR ? BLOCK_COMMENT_STAR : BLOCK_COMMENT;
+        transition[BLOCK_COMMENT_STAR][cc] = cc == STAR ? BLOCK_COMMENT_STAR : BLOCK_COMMENT;
+    }
+
+    transition[START][SINGLE] = SINGLE_CHAR;
+    for (int cc : {UNDERSCORE, LETTER, HEX_LETTER, E_LETTER, X_LETTER, ESCAPE_LETTER})
+        transition[START][cc] = IDENTIFIER;
+    transition[START][ZERO] = ZERO_START;
+    for (int cc : {OCTAL_DIGIT, EIGHT, NINE})
+        transition[START][cc] = DECIMAL_INT;
+    transition[START][DOT] = DOT_START;
+    transition[START][QUOTE] = RUNE_OPEN;
+    transition[START][DOUBLE_QUOTE] = STRING_BODY;
+    transition[START][BACK_QUOTE] = RAW_STRING_BODY;
+    transition[START][PLUS] = OP_PLUS;
+    transition[START][MINUS] = OP_MINUS;
+    transition[START][STAR] = OP_TIMES;
+    transition[START][SLASH] = OP_DIV;
+    transition[START][PERCENT] = OP_MOD;
+    transition[START][AMPERSAND] = OP_BW_AND;
+    transition[START][PIPE] = OP_BW_OR;
+    transition[START][CARET] = OP_BW_XOR;
+    transition[START][LESS] = OP_LT;
+    transition[START][GREATER] = OP_GT;
+    transition[START][EQUAL] = OP_ASSIGN;
+    transition[START][BANG] = OP_NOT;
+
+    for (int state : {ZERO_START, OCTAL_INT}) {
+        transition[state][ZERO] = transition[state][OCTAL_DIGIT] = OCTAL_INT;
+        transition[state][EIGHT] = transition[state][NINE] = BAD_OCTAL_INT;
+    }
+    transition[ZERO_START][X_LETTER] = HEX_START;
+    for (int state : {ZERO_START, OCTAL_INT, BAD_OCTAL_INT, DECIMAL_INT}) {
+        transition[state][DOT] = FRACTION;
+        transition[state][E_LETTER] = EXPONENT_START;
+    }
+    transition[FRACTION][E_LETTER] = EXPONENT_START;
+    transition[FRACTION][DOT] = EXTRA_CHARS;
+    transition[EXPONENT][DOT] = EXTRA_CHARS;
+    transition[EXPONENT_START][PLUS] = transition[EXPONENT_START][MINUS] = EXPONENT_SIGN;
+
+    transition[RUNE_CHAR][QUOTE] = RUNE_DONE;
+    transition[STRING_BODY][DOUBLE_QUOTE] = STRING_DONE;
+    transition[RAW_STRING_BODY][BACK_QUOTE] = RAW_STRING_DONE;
+    transition[BLOCK_COMMENT_STAR][SLASH] = BLOCK_COMMENT_DONE;
+
+    transition[OP_PLUS][PLUS] = OP_INCR;
+    transition[OP_PLUS][EQUAL] = OP_A_PLUS;
+    transition[OP_MINUS][MINUS] = OP_DECR;
+    transition[OP_MINUS][EQUAL] = OP_A_MINUS;
+    transition[OP_TIMES][EQUAL] = OP_A_TIMES;
+    transition[OP_DIV][SLASH] = LINE_COMMENT;
+    transition[OP_DIV][STAR] = BLOCK_COMMENT;
+    transition[OP_DIV][EQUAL] = OP_A_DIV;
+    transition[OP_MOD][EQUAL] = OP_A_MOD;
+    transition[OP_BW_AND][AMPERSAND] = OP_AND;
+    transition[OP_BW_AND][CARET] = OP_BW_AND_NOT;
+    transition[OP_BW_AND][EQUAL] = OP_A_BW_AND;
+    transition[OP_BW_AND_NOT][EQUAL] = OP_A_BW_AND_NOT;
+    transition[OP_BW_OR][PIPE] = OP_OR;
+    transition[OP_BW_OR][EQUAL] = OP_A_BW_OR;
+    transition[OP_BW_XOR][EQUAL] = OP_A_BW_XOR;
+    transition[OP_LT][LESS] = OP_L_SHIFT;
+    transition[OP_LT][EQUAL] = OP_LTE;
+    transition[OP_L_SHIFT][EQUAL] = OP_A_L_SHIFT;
+    transition[OP_GT][GREATER] = OP_R_SHIFT;
+    transition[OP_GT][EQUAL] = OP_GTE;
+    transition[OP_R_SHIFT][EQUAL] = OP_A_R_SHIFT;
+    transition[OP_ASSIGN][EQUAL] = OP_EQ;
+    transition[OP_NOT][EQUAL] = OP_NEQ;
+
+    auto &action = tables.action;
+    auto &token = tables.token;
+    for (int state = 0; state < NUM_OF_STATES; ++state)
+        action[state] = REJECT;
+    auto accept = [&action, &token](int state, int accepted_token) {
+        action[state] = ACCEPT;
+        token[state] = (std::uint8_t)accepted_token;
+    };
+    accept(SINGLE_CHAR, Token::NONE);
+    accept(IDENTIFIER, Token::IDENT);
+    accept(DOT_START, Token::DOT);
+    accept(ZERO_START, Token::OCTAL);
+    accept(OCTAL_INT, Token::OCTAL);
+    accept(DECIMAL_INT, Token::DEC);
+    accept(HEX_INT, Token::HEXADEC);
+    accept(FRACTION, Token::FLOAT);
+    accept(EXPONENT, Token::FLOAT);
+    accept(RUNE_DONE, Token::RUNE);
+    accept(STRING_DONE, Token::STRING);
+    accept(RAW_STRING_DONE, Token::R_STRING);
+    accept(OP_PLUS, Token::PLUS);
+    accept(OP_MINUS, Token::MINUS);
+    accept(OP_TIMES, Token::TIMES);
+    accept(OP_DIV, Token::DIV);
+    accept(OP_MOD, Token::MOD);
+    accept(OP_BW_AND, Token::BW_AND);
+    accept(OP_BW_AND_NOT, Token::BW_AND_NOT);
+    accept(OP_BW_OR, Token::BW_OR);
+    accept(OP_BW_XOR, Token::BW_XOR_NEG);
+    accept(OP_LT, Token::LT);
+    accept(OP_L_SHIFT, Token::L_SHIFT);
+    accept(OP_GT, Token::GT);
+    accept(OP_R_SHIFT, Token::R_SHIFT);
+    accept(OP_ASSIGN, Token::ASSIGN);
+    accept(OP_NOT, Token::NOT);
+    accept(OP_INCR, Token::INCR);
+    accept(OP_DECR, Token::DECR);
+    accept(OP_AND, Token::AND);
+    accept(OP_OR, Token::OR);
+    accept(OP_A_PLUS, Token::A_PLUS);
+    accept(OP_A_MINUS, Token::A_MINUS);
+    accept(OP_A_TIMES, Token::A_TIMES);
+    accept(OP_A_DIV, Token::A_DIV);
+    accept(OP_A_MOD, Token::A_MOD);
+    accept(OP_A_BW_AND, Token::A_BW_AND);
+    accept(OP_A_BW_AND_NOT, Token::A_BW_AND_NOT);
+    accept(OP_A_BW_OR, Token::A_BW_OR);
+    accept(OP_A_BW_XOR, Token::A_BW_XOR);
+    accept(OP_A_L_SHIFT, Token::A_L_SHIFT);
+    accept(OP_A_R_SHIFT, Token::A_R_SHIFT);
+    accept(OP_LTE, Token::LTE);
+    accept(OP_GTE, Token::GTE);
+    accept(OP_EQ, Token::EQ);
+    accept(OP_NEQ, Token::NEQ);
+    action[RUNE_ESCAPE] = REJECT_NEXT;
+    action[STRING_ESCAPE] = REJECT_NEXT;
+    action[LINE_COMMENT] = SKIP;
+    action[BLOCK_COMMENT_DONE] = SKIP;
+
+    for (int state : {RAW_STRING_BODY, RAW_STRING_DONE,
+                      BLOCK_COMMENT, BLOCK_COMMENT_STAR, BLOCK_COMMENT_DONE})
+        tables.multi_line[state] = true;
+
+    auto &run = tables.run;
+    run[IDENTIFIER] = IDENTIFIER_RUN;
+    for (int state : {DECIMAL_INT, BAD_OCTAL_INT, FRACTION, EXPONENT})
+        run[state] = DIGITS_RUN;
+    run[STRING_BODY] = STRING_RUN;
+    run[RAW_STRING_BODY] = RAW_STRING_RUN;
+    run[LINE_COMMENT] = LINE_COMMENT_RUN;
+    run[BLOCK_COMMENT] = BLOCK_COMMENT_RUN;
+
+    return tables;
+}
+
+
+inline constexpr LexicalAutomaton::Tables lexical_tables = LexicalAutomaton::build();
+
+#endif //ALGO_LEXICAL_AUTOMATON_H
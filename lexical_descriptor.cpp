@@ -1,11 +1,17 @@
 #include "lexical_descriptor.h"
 
 
-LexicalDescriptor::LexicalDescriptor() : token() { }
+LexicalDescriptor::LexicalDescriptor() : token(), line(0), identifier(0) { }
 
 
-LexicalDescriptor::LexicalDescriptor(Token token, const std::string &lexeme, size_t line) :
-        token(token), lexeme(lexeme), line(line) { }
+LexicalDescriptor::LexicalDescriptor(Token token, std::string_view lexeme, size_t line,
+                                     std::uint32_t identifier) :
+        token(token), lexeme(lexeme), line(line), identifier(identifier) { }
+
+
+LexicalDescriptor::LexicalDescriptor(Token token, std::string_view lexeme, size_t line,
+                                     const LiteralValue &literal) :
+        token(token), lexeme(lexeme), line(line), identifier(0), literal(literal) { }
 
 
 LexicalDescriptor::~LexicalDescriptor() { }
@@ -16,7 +22,7 @@ const Token &LexicalDescriptor::get_token() const {
 }
 
 
-const std::string &LexicalDescriptor::get_lexeme() const {
+std::string_view LexicalDescriptor::get_lexeme() const {
     return lexeme;
 }
 
@@ -24,3 +30,12 @@ const std::string &LexicalDescriptor::get_lexeme() const {
 size_t LexicalDescriptor::get_line_no() const {
     return line;
 }
+
+
+std::uint32_t LexicalDescriptor::get_identifier() const {
+    return identifier;
+}
+
+const LiteralValue &LexicalDescriptor::get_literal() const {
+    return literal;
+}
\ No newline at end of file
@@ -1,29 +1,42 @@
 #ifndef ALGO_LEXICAL_DESCRIPTOR_H
 #define ALGO_LEXICAL_DESCRIPTOR_H
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 
 #include "definitions.h"
+#include "literal.h"
 
 
 class LexicalDescriptor {
 public:
     LexicalDescriptor();
 
-    LexicalDescriptor(Token token, const std::string &lexeme, size_t line);
+    LexicalDescriptor(Token token, std::string_view lexeme, size_t line, std::uint32_t identifier = 0);
+
+    LexicalDescriptor(Token token, std::string_view lexeme, size_t line, const LiteralValue &literal);
 
     virtual ~LexicalDescriptor();
 
     const Token &get_token() const;
 
-    const std::string &get_lexeme() const;
+    // Slice of the source code; valid as long as the SourceCode is.
+    std::string_view get_lexeme() const;
 
     std::size_t get_line_no() const;
 
+    // Interned id of the name, for identifiers.
+    std::uint32_t get_identifier() const;
+
+    // Decoded value, for literals.
+    const LiteralValue &get_literal() const;
+
 private:
     Token token;
-    std::string lexeme;
+    std::string_view lexeme;
     std::size_t line;
+    std::uint32_t identifier;
+    LiteralValue literal;
 };
 
 #endif //ALGO_LEXICAL_DESCRIPTOR_H
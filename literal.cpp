@@ -0,0 +1,77 @@
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+#include "literal.h"
+
+
+static char parse_rune(std::string_view lex, std::size_t &p) {
+    if (lex[p] != '\\')
+        return lex[p];
+    ++p;
+    if (lex[p] == 'n')
+        return '\n';
+    if (lex[p] == 't')
+        return '\t';
+    if (lex[p] == '\\')
+        return '\\';
+    if (lex[p] == '\'')
+        return '\'';
+#ifdef DEBUG
+    assert(lex[p] == '"');
+#endif
+    return '"';
+}
+
+
+static void decode_int(std::string_view digits, int base, LiteralValue &literal) {
+    // A lone "0" is an octal literal without digits.
+    if (digits.empty())
+        return;
+    auto result = std::from_chars(digits.data(), digits.data() + digits.size(), literal.int_value, base);
+    literal.out_of_range = result.ec == std::errc::result_out_of_range;
+}
+
+
+static void decode_float(std::string_view lex, LiteralValue &literal) {
+    auto result = std::from_chars(lex.data(), lex.data() + lex.size(), literal.float_value);
+    if (result.ec == std::errc::result_out_of_range) {
+        // Either too large, which is an error, or too close to zero, which
+        // only loses precision; strtod tells them apart.
+        literal.float_value = std::strtod(std::string(lex).c_str(), nullptr);
+        literal.out_of_range = std::isinf(literal.float_value);
+    }
+}
+
+
+LiteralValue decode_literal(Token token, std::string_view lex, std::list<std::string> &strings) {
+    LiteralValue literal;
+    if (token == Token::DEC) {
+        decode_int(lex, 10, literal);
+    } else if (token == Token::OCTAL) {
+        decode_int(lex.substr(1), 8, literal);
+    } else if (token == Token::HEXADEC) {
+        decode_int(lex.substr(2), 16, literal);
+    } else if (token == Token::FLOAT) {
+        decode_float(lex, literal);
+    } else if (token == Token::RUNE) {
+        std::size_t p = 1;
+        literal.rune_value = parse_rune(lex, p);
+    } else if (token == Token::STRING and lex.find('\\') != std::string_view::npos) {
+        std::string value;
+        for (std::size_t i = 1; i < lex.size() - 1; ++i)
+            value.push_back(parse_rune(lex, i));
+        strings.push_back(std::move(value));
+        literal.string_value = strings.back();
+    } else {
+#ifdef DEBUG
+        assert(token == Token::STRING or token == Token::R_STRING);
+#endif
+        literal.string_value = lex.substr(1, lex.size() - 2);
+    }
+    return literal;
+}
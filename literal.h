@@ -0,0 +1,33 @@
+#ifndef ALGO_LITERAL_H
+#define ALGO_LITERAL_H
+
+#include <list>
+#include <string>
+#include <string_view>
+
+#include "definitions.h"
+
+
+// Decoded value of a literal token. String values are slices of the source
+// code when the literal has no escape sequences, and otherwise point to
+// storage owned by whoever decoded them.
+struct LiteralValue {
+    union {
+        long int_value;
+        double float_value;
+        char rune_value;
+    };
+    std::string_view string_value;
+    // The value does not fit its type, so int_value or float_value are
+    // meaningless.
+    bool out_of_range;
+
+    LiteralValue() : int_value(0), out_of_range(false) { }
+};
+
+
+// Decodes the lexeme of a literal token exactly. Strings with escape
+// sequences are decoded into a new element of strings.
+LiteralValue decode_literal(Token token, std::string_view lex, std::list<std::string> &strings);
+
+#endif //ALGO_LITERAL_H
@@ -1,18 +1,154 @@
+#include <chrono>
 #include <iostream>
 
 #include "lexical_analyzer.h"
 #include "analyzer.h"
+#include "command_line.h"
+#include "token_buffer.h"
 
 
 using namespace std;
 
 
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+
+static int usage_error(const string &message) {
+    cerr << message << endl;
+    cerr << "Usage: algo [--buffered | --pipelined] [--threads=N] [--parallel] [--descent] [--syntax-only]" << endl <<
+            "            [--ast] [--max-errors=N] [--compact-errors] [--stats] <file>" << endl;
+    return 1;
+}
+
+
+// The work done by the analysis and how long it took, lexing included
+// unless the tokens were buffered.
+static void print_statistics(const Analyzer &syntax, double parse_time, const Ast *ast) {
+    const Analyzer::Statistics &stats = syntax.get_statistics();
+    clog << "parsing " << parse_time << " ms, " << stats.expressions << " expressions, " << stats.expansions <<
+            " expansions, " << stats.rules << " rules" << endl;
+    if (ast)
+        clog << ast->size() << " nodes, " << ast->size() * sizeof(AstNode) << " bytes" << endl;
+}
+
+
 int main(int argc, char *argv[]) {
-    SourceCode src(argv[1]);
-    LexicalAnalyzer lex(&src);
+    bool buffered = false, pipelined = false, descent = false, syntax_only = false, build_ast = false;
+    bool parallel = false, show_stats = false;
+    size_t threads = 1;
+    size_t max_errors = Diagnostics::NO_LIMIT;
+    Diagnostics::Format format = Diagnostics::Format::TEXT;
+    string filename;
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg == "--buffered") {
+            buffered = true;
+        } else if (arg == "--descent") {
+            // The generated recursive-descent engine. It does not recover
+            // from syntax errors: it stops at the first one, so on such input
+            // it only reports a prefix of what the default engine does.
+            descent = true;
+        } else if (arg == "--syntax-only") {
+            syntax_only = true;
+        } else if (arg == "--parallel") {
+            // Parses the declarations on the threads of --threads.
+            parallel = true;
+            buffered = true;
+        } else if (arg == "--ast") {
+            build_ast = true;
+        } else if (arg == "--pipelined") {
+            pipelined = true;
+        } else if (arg == "--stats") {
+            // Timings and work done, on standard error after the diagnostics.
+            show_stats = true;
+        } else if (arg.compare(0, 13, "--max-errors=") == 0) {
+            // Stops the analysis at the Nth diagnostic; 0 is no limit.
+            if (not parse_count(string_view(arg).substr(13), max_errors))
+                return usage_error("Invalid number of errors in " + arg + ".");
+            if (max_errors == 0)
+                max_errors = Diagnostics::NO_LIMIT;
+        } else if (arg == "--compact-errors") {
+            // One line of tab-separated fields per diagnostic, for tools.
+            format = Diagnostics::Format::COMPACT;
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            // Lexing on several threads needs the whole token stream anyway.
+            if (not parse_count(string_view(arg).substr(10), threads) or threads == 0 or threads > UINT32_MAX)
+                return usage_error("Invalid number of threads in " + arg + ".");
+            buffered = true;
+        } else {
+            filename = arg;
+        }
+    }
+
+    if (parallel and (descent or syntax_only or build_ast))
+        return usage_error("--parallel runs the full table-driven analysis and builds no tree.");
+    if (pipelined and buffered)
+        return usage_error("--pipelined lexes while parsing, so it excludes --buffered, --threads and --parallel.");
+    if (descent and (syntax_only or build_ast))
+        return usage_error("--descent runs the full analysis and builds no tree.");
+
+    SourceCode src(filename);
+    Ast ast;
+    Diagnostics diagnostics(&cerr, format, max_errors);
+    if (buffered) {
+        // Lexes the whole file first, so that both stages can be timed.
+        auto start = chrono::steady_clock::now();
+        TokenBuffer tokens(&src, (unsigned)threads);
+        double lex_time = elapsed_ms(start);
+
+        start = chrono::steady_clock::now();
+        Analyzer syntax(&tokens);
+        syntax.report_to(&diagnostics);
+        if (build_ast)
+            syntax.build_ast(&ast);
+        bool result;
+        if (descent)
+            result = syntax.analyze_descent();
+        else if (parallel)
+            result = syntax.analyze_parallel((unsigned)threads);
+        else
+            result = syntax.analyze(syntax_only);
+        double parse_time = elapsed_ms(start);
+
+        cout << result << endl;
+        if (show_stats) {
+            clog << tokens.size() << " tokens, lexing " << lex_time << " ms" << endl;
+            print_statistics(syntax, parse_time, build_ast ? &ast : nullptr);
+        }
+        return 0;
+    }
+
+    if (pipelined) {
+        PipelinedLexer lex(&src);
+        Analyzer syntax(&lex);
+        syntax.report_to(&diagnostics);
+        if (build_ast)
+            syntax.build_ast(&ast);
+
+        auto start = chrono::steady_clock::now();
+        cout << (descent ? syntax.analyze_descent() : syntax.analyze(syntax_only)) << endl;
+        if (show_stats) {
+            clog << "lexer stalled " << chrono::duration<double, milli>(lex.get_lexer_stall()).count() <<
+                    " ms, parser stalled " << chrono::duration<double, milli>(lex.get_consumer_stall()).count() <<
+                    " ms" << endl;
+            print_statistics(syntax, elapsed_ms(start), build_ast ? &ast : nullptr);
+        }
+        return 0;
+    }
+
+    Interner interner;
+    LexicalAnalyzer lex(&src, &interner);
     Analyzer syntax(&lex);
+    syntax.report_to(&diagnostics);
+    if (build_ast)
+        syntax.build_ast(&ast);
 
-    cout << syntax.analyze() << endl;
+    auto start = chrono::steady_clock::now();
+    cout << (descent ? syntax.analyze_descent() : syntax.analyze(syntax_only)) << endl;
+    if (show_stats)
+        print_statistics(syntax, elapsed_ms(start), build_ast ? &ast : nullptr);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#ifndef ALGO_PARSE_STACK_H
+#define ALGO_PARSE_STACK_H
+
+#include <cstring>
+#include <memory>
+
+#include "grammar.h"
+
+
+// Contiguous stack of the analyzer, with whole productions pushed by a
+// single copy.
+class ParseStack {
+public:
+    explicit ParseStack(std::size_t capacity = 1024) : items(new ProductionItem[capacity]), count(0),
+                                                        capacity(capacity) { }
+
+    virtual ~ParseStack() { }
+
+    void push(ProductionItem item) {
+        if (count == capacity)
+            _grow(count + 1);
+        items[count++] = item;
+    }
+
+    // Pushes items[0] first, so that items[size - 1] ends up on top.
+    void push(const ProductionItem *pushed, std::size_t size) {
+        if (count + size > capacity)
+            _grow(count + size);
+        std::memcpy(&items[count], pushed, size * sizeof(ProductionItem));
+        count += size;
+    }
+
+    ProductionItem top() const {
+        return items[count - 1];
+    }
+
+    void pop() {
+        --count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+private:
+    void _grow(std::size_t needed) {
+        while (capacity < needed)
+            capacity *= 2;
+        std::unique_ptr<ProductionItem[]> grown(new ProductionItem[capacity]);
+        std::memcpy(grown.get(), items.get(), count * sizeof(ProductionItem));
+        items = std::move(grown);
+    }
+
+    std::unique_ptr<ProductionItem[]> items;
+    std::size_t count;
+    std::size_t capacity;
+};
+
+#endif //ALGO_PARSE_STACK_H
@@ -0,0 +1,76 @@
+// Times LL(1) predictions with the dense parse table against the map per
+// non-terminal the analyzer used to keep.
+//
+//   parse_table_benchmark [lookups]
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "grammar.h"
+
+
+using namespace std;
+
+
+struct Lookup {
+    int non_terminal;
+    int token;
+};
+
+
+template <typename Predict>
+static double time_ns(const vector<Lookup> &lookups, Predict predict, long &checksum) {
+    auto start = chrono::steady_clock::now();
+    long sum = 0;
+    for (const Lookup &lookup : lookups)
+        sum += predict(lookup);
+    auto elapsed = chrono::steady_clock::now() - start;
+    checksum = sum;
+    return chrono::duration<double, nano>(elapsed).count() / lookups.size();
+}
+
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? stoul(argv[1]) : 20000000;
+
+    vector<map<Token, int>> map_table(grammar::NUM_OF_NON_TERMINALS);
+    for (const auto &entry : grammar::syntactic_table_entries)
+        map_table[entry.non_terminal - SyntaxSymbol::FIRST_NON_TERMINAL][entry.token] = entry.production;
+
+    // Mostly predictions that exist, as in a correct program, with some
+    // misses mixed in as error recovery would ask for.
+    mt19937 random(42);
+    uniform_int_distribution<size_t> entry_index(0, size(grammar::syntactic_table_entries) - 1);
+    uniform_int_distribution<int> non_terminal(0, grammar::NUM_OF_NON_TERMINALS - 1), token(0, Token::STR);
+    vector<Lookup> lookups(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 8) {
+            const auto &entry = grammar::syntactic_table_entries[entry_index(random)];
+            lookups[i] = {entry.non_terminal - SyntaxSymbol::FIRST_NON_TERMINAL, entry.token};
+        } else {
+            lookups[i] = {non_terminal(random), token(random)};
+        }
+    }
+
+    long map_sum, dense_sum;
+    double map_ns = time_ns(lookups, [&](const Lookup &lookup) {
+        auto &row = map_table[lookup.non_terminal];
+        auto it = row.find(lookup.token);
+        return it == row.end() ? -1 : it->second;
+    }, map_sum);
+    double dense_ns = time_ns(lookups, [](const Lookup &lookup) {
+        return (int)grammar::parse_table[lookup.non_terminal][lookup.token];
+    }, dense_sum);
+
+    if (map_sum != dense_sum) {
+        cerr << "The tables disagree" << endl;
+        return 1;
+    }
+    cout << count << " lookups, map " << map_ns << " ns/lookup, dense " << dense_ns << " ns/lookup (" <<
+            map_ns / dense_ns << "x), dense table " << sizeof(grammar::parse_table) << " bytes" << endl;
+    return 0;
+}
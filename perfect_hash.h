@@ -0,0 +1,108 @@
+#ifndef ALGO_PERFECT_HASH_H
+#define ALGO_PERFECT_HASH_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+
+// Collision-free table from a fixed set of names to values, built entirely
+// at compile time. Names are first spread over buckets by their length,
+// first and last characters; each bucket then gets a displacement moving
+// its names to free slots, so a lookup hashes the name, probes exactly one
+// slot and compares it with a single memcmp.
+template <std::size_t BUCKETS, std::size_t SLOTS>
+class PerfectHash {
+public:
+    struct Entry {
+        const char *name;
+        int value;
+    };
+
+    template <std::size_t N>
+    static constexpr PerfectHash build(const Entry (&entries)[N]) {
+        PerfectHash table{};
+        std::array<std::size_t, BUCKETS> bucket_size{};
+        for (const auto &entry : entries)
+            ++bucket_size[_bucket(entry.name)];
+
+        std::array<bool, BUCKETS> placed{};
+        for (std::size_t round = 0; round < BUCKETS; ++round) {
+            std::size_t bucket = 0;
+            for (std::size_t b = 0; b < BUCKETS; ++b)
+                if (not placed[b] and (placed[bucket] or bucket_size[b] > bucket_size[bucket]))
+                    bucket = b;
+            placed[bucket] = true;
+            if (bucket_size[bucket] == 0)
+                continue;
+
+            std::size_t displacement = 0;
+            while (displacement < SLOTS and not table._fits(entries, bucket, displacement))
+                ++displacement;
+            if (displacement == SLOTS)
+                return table;
+            table.displacement[bucket] = (std::uint16_t)displacement;
+            for (const auto &entry : entries)
+                if (_bucket(entry.name) == bucket)
+                    table.slots[_slot(entry.name, displacement)] =
+                            {entry.name, std::string_view(entry.name).size(), entry.value};
+        }
+        table.complete = true;
+        return table;
+    }
+
+    // Whether every name found a slot of its own.
+    constexpr bool is_complete() const {
+        return complete;
+    }
+
+    int find(std::string_view name, int missing) const {
+        if (name.empty())
+            return missing;
+        const Slot &slot = slots[_slot(name, displacement[_bucket(name)])];
+        if (slot.length != name.size() or std::memcmp(slot.name, name.data(), name.size()) != 0)
+            return missing;
+        return slot.value;
+    }
+
+private:
+    struct Slot {
+        const char *name;
+        std::size_t length;
+        int value;
+    };
+
+    static constexpr std::size_t _bucket(std::string_view name) {
+        return (name.size() + (unsigned char)name.front() * 101u +
+                (unsigned char)name.back() * 17u) % BUCKETS;
+    }
+
+    static constexpr std::size_t _slot(std::string_view name, std::size_t displacement) {
+        std::size_t length = name.size();
+        std::size_t third = (unsigned char)name[length > 2 ? 2 : length - 1];
+        std::size_t third_last = (unsigned char)name[length > 3 ? length - 3 : 0];
+        return (length * 41u + (unsigned char)name.front() + (unsigned char)name.back() * 101u +
+                third * 31u + third_last * 101u + displacement) % SLOTS;
+    }
+
+    template <std::size_t N>
+    constexpr bool _fits(const Entry (&entries)[N], std::size_t bucket, std::size_t displacement) const {
+        std::array<bool, SLOTS> taken{};
+        for (const auto &entry : entries) {
+            if (_bucket(entry.name) != bucket)
+                continue;
+            std::size_t slot = _slot(entry.name, displacement);
+            if (taken[slot] or slots[slot].name != nullptr)
+                return false;
+            taken[slot] = true;
+        }
+        return true;
+    }
+
+    std::array<std::uint16_t, BUCKETS> displacement;
+    std::array<Slot, SLOTS> slots;
+    bool complete;
+};
+
+#endif //ALGO_PERFECT_HASH_H
@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include "pipelined_lexer.h"
+
+
+PipelinedLexer::PipelinedLexer(SourceCode *source_code, std::size_t capacity) :
+        source_code(source_code), interner(), lexical_analyzer(source_code, &interner), ring(capacity),
+        literals(capacity), wake_batch(std::min(capacity, WAKE_BATCH)), pushed(0), popped(0), cancelled(false), lexer_stall(0), consumer_stall(0) {
+    thread = std::thread(&PipelinedLexer::_run, this);
+}
+
+
+PipelinedLexer::~PipelinedLexer() {
+    cancelled.store(true, std::memory_order_relaxed);
+    _wake(lexer_parking);
+    thread.join();
+}
+
+
+LexicalDescriptor PipelinedLexer::next() {
+    Record record;
+    if (not ring.try_pop(record))
+        consumer_stall += _wait(consumer_parking, [&]() {
+            return ring.try_pop(record);
+        });
+    // The lexer sleeps only on a full ring, which takes more than a batch
+    // to empty.
+    if (++popped % wake_batch == 0)
+        _wake(lexer_parking);
+    std::string_view lexeme(source_code->begin() + record.offset, record.length);
+    if (not record.token.is_literal())
+        return {record.token, lexeme, record.line, record.identifier};
+
+    // Pushed before its token, so it is already there.
+    LiteralValue literal;
+    literals.try_pop(literal);
+    return {record.token, lexeme, record.line, literal};
+}
+
+
+void PipelinedLexer::_run() {
+    while (true) {
+        LexicalDescriptor descriptor = lexical_analyzer.next();
+        Token token = descriptor.get_token();
+        std::string_view lexeme = descriptor.get_lexeme();
+        if (token.is_literal() and not _push(literals, descriptor.get_literal()))
+            return;
+        if (not _push(ring, Record{token, (std::uint32_t)descriptor.get_line_no(), descriptor.get_identifier(),
+                                   (std::uint32_t)(lexeme.data() - source_code->begin()),
+                                   (std::uint32_t)lexeme.size()}))
+            return;
+        if (++pushed % wake_batch == 0 or token == Token::NONE)
+            _wake(consumer_parking);
+        if (token == Token::NONE)
+            return;
+    }
+}
+
+
+template <typename T>
+bool PipelinedLexer::_push(SpscRing<T> &queue, const T &item) {
+    if (queue.try_push(item))
+        return true;
+    std::chrono::nanoseconds stall = _wait(lexer_parking, [&]() {
+        return cancelled.load(std::memory_order_relaxed) or queue.try_push(item);
+    });
+    lexer_stall.fetch_add(stall.count(), std::memory_order_relaxed);
+    return not cancelled.load(std::memory_order_relaxed);
+}
+
+
+template <typename Ready>
+std::chrono::nanoseconds PipelinedLexer::_wait(Parking &parking, Ready ready) {
+    auto start = std::chrono::steady_clock::now();
+    bool done = false;
+    for (int i = 0; i < SPINS and not done; ++i) {
+        std::this_thread::yield();
+        done = ready();
+    }
+    if (not done) {
+        std::unique_lock<std::mutex> lock(parking.mutex);
+        parking.sleeping.store(true, std::memory_order_relaxed);
+        // Either _wake sees sleeping, or ready sees what the other side did
+        // before calling it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        parking.condition.wait(lock, ready);
+        parking.sleeping.store(false, std::memory_order_relaxed);
+    }
+    return std::chrono::steady_clock::now() - start;
+}
+
+
+void PipelinedLexer::_wake(Parking &parking) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parking.sleeping.load(std::memory_order_relaxed)) {
+        // Taken so that the sleeper is either waiting already or has yet to
+        // check ready.
+        std::lock_guard<std::mutex> lock(parking.mutex);
+        parking.condition.notify_one();
+    }
+}
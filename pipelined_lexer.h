@@ -0,0 +1,105 @@
+#ifndef ALGO_PIPELINED_LEXER_H
+#define ALGO_PIPELINED_LEXER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "lexical_analyzer.h"
+#include "spsc_ring.h"
+
+
+// Runs a LexicalAnalyzer on a thread of its own, handing its tokens over
+// through a bounded ring, so lexing overlaps with parsing while at most
+// capacity tokens are held in memory. A side that finds the ring empty or
+// full spins for a while, then sleeps until the other one wakes it. Both
+// sides keep count of the time they spend waiting for the other one.
+class PipelinedLexer {
+public:
+    explicit PipelinedLexer(SourceCode *source_code, std::size_t capacity = 4096);
+
+    PipelinedLexer(const PipelinedLexer &) = delete;
+
+    PipelinedLexer &operator=(const PipelinedLexer &) = delete;
+
+    // Stops the lexer thread if the consumer did not get to the end.
+    virtual ~PipelinedLexer();
+
+    // Consumer side; the same tokens as LexicalAnalyzer::next.
+    LexicalDescriptor next();
+
+    Interner *get_interner() {
+        return &interner;
+    }
+
+    // Time the lexer spent waiting for room in the ring.
+    std::chrono::nanoseconds get_lexer_stall() const {
+        return std::chrono::nanoseconds(lexer_stall.load(std::memory_order_relaxed));
+    }
+
+    // Time the consumer spent waiting for tokens.
+    std::chrono::nanoseconds get_consumer_stall() const {
+        return consumer_stall;
+    }
+
+private:
+    // A token as the ring carries it. The values of literals go through a
+    // ring of their own, in the same order as their tokens.
+    struct Record {
+        Token token;
+        std::uint32_t line;
+        // Interned id of an identifier.
+        std::uint32_t identifier;
+        // The lexeme, in the source code.
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    // Where a side sleeps once it has spun long enough.
+    struct Parking {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<bool> sleeping{false};
+    };
+
+    // Tries before a side goes to sleep.
+    static constexpr int SPINS = 64;
+    // Tokens a side hands over or takes between checks for a sleeper, so
+    // that one woken up has a batch to work on.
+    static constexpr std::size_t WAKE_BATCH = 256;
+
+    void _run();
+
+    // Lexer side; false if cancelled while waiting for room.
+    template <typename T>
+    bool _push(SpscRing<T> &queue, const T &item);
+
+    // Returns how long it took for ready() to hold.
+    template <typename Ready>
+    std::chrono::nanoseconds _wait(Parking &parking, Ready ready);
+
+    // Wakes the other side if it sleeps in parking.
+    static void _wake(Parking &parking);
+
+    SourceCode *source_code;
+    Interner interner;
+    LexicalAnalyzer lexical_analyzer;
+    SpscRing<Record> ring;
+    SpscRing<LiteralValue> literals;
+    // The lexer waits in one for room, the consumer in the other for tokens.
+    Parking lexer_parking;
+    Parking consumer_parking;
+    std::size_t wake_batch;
+    // Tokens the lexer handed over, and the consumer took.
+    std::size_t pushed;
+    std::size_t popped;
+    std::atomic<bool> cancelled;
+    std::atomic<std::chrono::nanoseconds::rep> lexer_stall;
+    std::chrono::nanoseconds consumer_stall;
+    std::thread thread;
+};
+
+#endif //ALGO_PIPELINED_LEXER_H
@@ -0,0 +1,103 @@
+// Times the table-driven analyzer on generated files full of syntax errors,
+// at doubling sizes, to show that error recovery stays linear in the input:
+// the time per token should not grow with the size.
+//
+//   recovery_benchmark [tokens]
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "analyzer.h"
+
+
+using namespace std;
+
+
+static const char *const PRELUDE = "package p;\nvar x int;\nvar b bool;\nfunc f() {\n";
+
+
+// Whole statements, each with a stray token, so that every one is reported
+// and recovered from.
+static string stray_statements(size_t tokens) {
+    string code = PRELUDE;
+    for (size_t i = 0; i < tokens; i += 5)
+        code += "x = ) 1;\n";
+    return code + "}\n";
+}
+
+
+// Stray closing brackets deep inside nested parentheses: the first one
+// unwinds the nesting, the rest are skipped.
+static string nested_brackets(size_t tokens) {
+    string code = PRELUDE;
+    code += "x = ";
+    for (size_t i = 0; i < tokens / 2; ++i)
+        code += "(";
+    code += "1";
+    for (size_t i = 0; i < tokens / 2; ++i)
+        code += " ]";
+    return code + ";\n}\n";
+}
+
+
+// Tokens that no symbol synchronizes on, inside nested blocks.
+static string junk_in_blocks(size_t tokens) {
+    string code = PRELUDE;
+    for (int i = 0; i < 100; ++i)
+        code += "if b {\n";
+    for (size_t i = 0; i < tokens; ++i)
+        code += "package ";
+    code += "\n";
+    for (int i = 0; i < 100; ++i)
+        code += "}\n";
+    return code + "}\n";
+}
+
+
+// Operators without operands, which recovery inside expressions handles.
+static string broken_expressions(size_t tokens) {
+    string code = PRELUDE;
+    for (size_t i = 0; i < tokens; i += 8)
+        code += "x = 1 + * 2 == ;\n";
+    return code + "}\n";
+}
+
+
+int main(int argc, char *argv[]) {
+    size_t max_tokens = argc > 1 ? stoul(argv[1]) : 1000000;
+
+    const pair<const char *, function<string(size_t)>> generators[] = {
+            {"stray statements", stray_statements},
+            {"nested brackets", nested_brackets},
+            {"junk in blocks", junk_in_blocks},
+            {"broken expressions", broken_expressions}
+    };
+
+    string filename = (filesystem::temp_directory_path() / "recovery_benchmark.algo").string();
+    // The diagnostics are not what is being timed.
+    cerr.rdbuf(nullptr);
+
+    for (const auto &generator : generators) {
+        cout << generator.first << ":" << endl;
+        for (size_t tokens = max_tokens / 8; tokens <= max_tokens; tokens *= 2) {
+            ofstream(filename) << generator.second(tokens);
+            SourceCode source_code(filename);
+            TokenBuffer token_buffer(&source_code);
+
+            Analyzer analyzer(&token_buffer);
+            auto start = chrono::steady_clock::now();
+            bool result = analyzer.analyze();
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            cout << "  " << token_buffer.size() << " tokens, " << ms << " ms, " <<
+                    ms * 1e6 / token_buffer.size() << " ns per token" << (result ? "" : ", rejected") << endl;
+        }
+    }
+    remove(filename.c_str());
+    return 0;
+}
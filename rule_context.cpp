@@ -5,181 +5,115 @@
 #include "rule_context.h"
 
 
-RuleContext::RuleContext() :
+RuleContext::RuleContext(const Interner *interner) :
+        interner(interner),
         symbol_table(),
-        lexemes(new std::stack<std::string>[Token::NUM_OF_TOKENS]),
-        attributes(new std::vector<SymbolAttributes>[SyntaxSymbol::NUM_OF_SYMBOLS]) {
+        literals(new std::stack<LiteralValue, std::vector<LiteralValue>>[Token::NUM_OF_TOKENS]),
+        slots(new std::vector<std::uint32_t>[SyntaxSymbol::NUM_OF_SYMBOLS]) {
 }
 
 
 RuleContext::~RuleContext() {
 #ifdef DEBUG
     for (std::size_t i = 0; i < Token::NUM_OF_TOKENS; ++i) {
-        assert(lexemes[i].empty());
-        assert(attributes[i].empty());
+        assert(literals[i].empty());
+        assert(slots[i].empty());
     }
+    assert(identifiers.empty());
+    assert(records.empty());
 #endif
-    delete[] lexemes;
-    delete[] attributes;
+    delete[] literals;
+    delete[] slots;
 }
 
 
 void RuleContext::add_symbol(Token token) {
-    attributes[token].push_back(SymbolAttributes{});
+    slots[token].push_back((std::uint32_t)records.size());
+    records.emplace_back();
 }
 
 
-void RuleContext::set_lexeme(Token token, std::string lex) {
+void RuleContext::set_literal(Token token, const LiteralValue &literal) {
 #ifdef DEBUG
-    assert(not attributes[token].empty());
+    assert(not slots[token].empty());
 #endif
-    lexemes[token].push(lex);
+    literals[token].push(literal);
 }
 
 
-void RuleContext::remove_symbol(Token token) {
-    if (token.variable_lexeme()) {
-#ifdef DEBUG
-        assert(not lexemes[token].empty());
-#endif
-        lexemes[token].pop();
-    }
+void RuleContext::set_identifier(std::uint32_t id) {
 #ifdef DEBUG
-    assert(not attributes[token].empty());
+    assert(not slots[Token::IDENT].empty());
 #endif
-    attributes[token].pop_back();
+    identifiers.push(id);
 }
 
 
-SymbolAttributes &RuleContext::get_attributes(SyntaxSymbol symbol,
-                                              std::size_t r_idx) const {
-#ifdef DEBUG
-    assert(attributes[symbol].size() > r_idx);
-#endif
-    return attributes[symbol][attributes[symbol].size() - r_idx - 1];
+void RuleContext::remove_symbol(Token token) {
+    _remove_slot(token);
+    records.pop_back();
 }
 
 
-std::string RuleContext::get_lexeme(Token token) const {
+void RuleContext::_remove_slot(Token token) {
+    if (token == Token::IDENT) {
 #ifdef DEBUG
-    assert(not lexemes[token].empty());
+        assert(not identifiers.empty());
 #endif
-    return lexemes[token].top();
-}
-
-bool RuleContext::get_bool_value(Token token) const {
-    if (token == Token::TRUE)
-        return true;
-    if (token == Token::FALSE)
-        return false;
+        identifiers.pop();
+    } else if (token.is_literal()) {
 #ifdef DEBUG
-    assert(false);
+        assert(not literals[token].empty());
 #endif
-}
-
-
-long RuleContext::get_int_value(Token token) const {
-    std::string lex = get_lexeme(token);
-    long value = 0;
-    if (token == Token::DEC) {
-        for (char c : lex)
-            value = value * 10 + (c - '0');
-    } else if (token == Token::OCTAL) {
-        for (char c : lex.substr(1))
-            value = value * 8 + (c - '0');
-    } else if (token == Token::HEXADEC) {
-        for (char c : lex.substr(2))
-            value = value * 16 + (c <= '9' ? c - '0' : c - 'a' + 10);
+        literals[token].pop();
     }
 #ifdef DEBUG
-    else
-        assert(false);
+    assert(not slots[token].empty());
 #endif
-    return value;
+    slots[token].pop_back();
 }
 
 
-double RuleContext::get_float_value(Token token) const {
+void RuleContext::clear() {
+    for (int i = 0; i < Token::NUM_OF_TOKENS; ++i)
+        literals[i] = std::stack<LiteralValue, std::vector<LiteralValue>>();
+    for (int i = 0; i < SyntaxSymbol::NUM_OF_SYMBOLS; ++i)
+        slots[i].clear();
+    records.clear();
+    identifiers = std::stack<std::uint32_t, std::vector<std::uint32_t>>();
+}
+
+
+SymbolAttributes &RuleContext::get_attributes(SyntaxSymbol symbol, std::size_t r_idx) {
 #ifdef DEBUG
-    if (token != Token::FLOAT)
-        assert(false);
+    assert(slots[symbol].size() > r_idx);
+    assert(running_rule == NO_RULE or rule_slots[running_rule].declares(symbol, r_idx));
 #endif
-    std::string lex = get_lexeme(token);
-    double value = 0;
-    std::size_t i = 0;
-    while (lex[i] != '.' and lex[i] != 'e' and lex[i] != 'E')
-        value = value * 10 + (lex[i++] - '0');
-    if (lex[i] == '.') {
-        double div = .1;
-        ++i;
-        while (i < lex.size() and lex[i] != 'e' and lex[i] != 'E') {
-            value += (lex[i++] - '0') * div;
-            div *= .1;
-        }
-    }
-    if (i < lex.size() and (lex[i] == 'e' or lex[i] == 'E')) {
-        int exp = 0;
-        bool neg = false;
-        ++i;
-        if (lex[i] == '-') {
-            neg = true;
-            ++i;
-        } else if (lex[i] == '+') {
-            ++i;
-        }
-        while (i < lex.size())
-            exp = exp * 10 + (lex[i++] - '0');
-        if (neg)
-            exp = -exp;
-        value = value * std::pow(10, exp);
-    }
-    return value;
+    return records[slots[symbol][slots[symbol].size() - r_idx - 1]];
 }
 
 
-char RuleContext::get_rune_value(Token token) const {
+const LiteralValue &RuleContext::get_literal(Token token) const {
 #ifdef DEBUG
-    if (token != Token::RUNE)
-        assert(false);
+    assert(not literals[token].empty());
 #endif
-    std::string lex = get_lexeme(token);
-    std::size_t p = 1;
-    return _parse_rune(lex, p);
+    return literals[token].top();
 }
 
 
-std::string RuleContext::get_string_value(Token token) const {
-    std::string lex = get_lexeme(token);
-    std::string value;
-    if (token == Token::STRING) {
-        for (std::size_t i = 1; i < lex.size() - 1; ++i)
-            value.push_back(_parse_rune(lex, i));
-    } else if (token == Token::R_STRING) {
-        for (std::size_t i = 1; i < lex.size() - 1; ++i)
-            value.push_back(lex[i]);
-    }
+std::uint32_t RuleContext::get_identifier() const {
 #ifdef DEBUG
-    else
-        assert(false);
+    assert(not identifiers.empty());
 #endif
-    return value;
+    return identifiers.top();
 }
 
 
-char RuleContext::_parse_rune(std::string lex, std::size_t &p) const {
-    if (lex[p] != '\\')
-        return lex[1];
-    ++p;
-    if (lex[p] == 'n')
-        return '\n';
-    if (lex[p] == 't')
-        return '\t';
-    if (lex[p] == '\\')
-        return '\\';
-    if (lex[p] == '\'')
-        return '\'';
-    if (lex[p] == '"')
-        return '"';
+bool RuleContext::get_bool_value(Token token) const {
+    if (token == Token::TRUE)
+        return true;
+    if (token == Token::FALSE)
+        return false;
 #ifdef DEBUG
     assert(false);
 #endif
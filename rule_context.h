@@ -1,61 +1,136 @@
 #ifndef ALGO_RULE_CONTEXT_H
 #define ALGO_RULE_CONTEXT_H
 
-#include <cmath>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "definitions.h"
+#include "interner.h"
+#include "literal.h"
+#include "rule_slots.h"
 #include "symbol_table.h"
+#include "type_table.h"
 
 
+// The record of a slot of the context, small enough to copy freely.
 struct SymbolAttributes : public SymbolTableRecord {
-    std::size_t line_no;
-    TypeDim return_type_dim;
-    bool in_loop;
-    bool is_lvalue;
-    bool is_literal;
-    bool three_for;
-    std::string identifier;
-    Operation operation;
+    TypeId return_type_dim = TypeTable::scalar(Type::VOID);
+    std::uint32_t identifier = 0;
+    std::uint32_t line_no = 0;
+    Operation operation = Operation::NONE;
+    bool in_loop = false;
+    bool is_lvalue = false;
+    bool is_literal = false;
+    bool three_for = false;
 };
 
 
+// The slots of each symbol are indices into a stack of records, which
+// the slots of a production push when it is expanded and pop when it ends.
+// Slots that a copy rule would only copy between can share one record
+// instead, as grammar::slot_aliases finds them. The vectors keep their
+// room as slots are removed, so adding one later reuses it.
 class RuleContext {
 public:
-    explicit RuleContext();
+    static constexpr int NO_RULE = -1;
+
+    // Names of identifiers are looked up in interner.
+    explicit RuleContext(const Interner *interner);
 
     virtual ~RuleContext();
 
     void add_symbol(Token token);
 
-    void set_lexeme(Token token, std::string lex);
+    // Adds the slots of the symbols of an expanded production at once.
+    // aliases, if given, has the SlotRecord of each, and head is then the
+    // symbol expanded.
+    void add_symbols(const int *symbols, std::size_t count, SyntaxSymbol head = SyntaxSymbol::NONE,
+                     const std::int8_t *aliases = nullptr) {
+        std::uint32_t base = (std::uint32_t)records.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint32_t record;
+            if (not aliases or aliases[i] == OWN_RECORD) {
+                record = (std::uint32_t)records.size();
+                records.emplace_back();
+            } else if (aliases[i] == HEAD_RECORD) {
+                record = slots[head].back();
+            } else {
+                record = base + aliases[i];
+            }
+            slots[symbols[i]].push_back(record);
+        }
+    }
+
+    void set_literal(Token token, const LiteralValue &literal);
+
+    void set_identifier(std::uint32_t id);
 
     void remove_symbol(Token token);
 
-    SymbolAttributes &get_attributes(SyntaxSymbol symbol,
-                                     std::size_t r_idx = 0) const;
+    // Takes the aliases add_symbols was given.
+    void remove_symbols(const int *symbols, std::size_t count, const std::int8_t *aliases = nullptr) {
+        std::size_t owned = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            _remove_slot(symbols[i]);
+            owned += not aliases or aliases[i] == OWN_RECORD;
+        }
+        records.resize(records.size() - owned);
+    }
 
-    std::string get_lexeme(Token token) const;
+    // Drops every slot, literal and identifier, as when a parse is given up.
+    void clear();
 
-    bool get_bool_value(Token token) const;
+    SymbolAttributes &get_attributes(SyntaxSymbol symbol, std::size_t r_idx = 0);
 
-    long get_int_value(Token token) const;
+    // Value of the innermost literal of the kind of token.
+    const LiteralValue &get_literal(Token token) const;
 
-    double get_float_value(Token token) const;
+    // Interned id of the innermost identifier.
+    std::uint32_t get_identifier() const;
 
-    char get_rune_value(Token token) const;
+    // A slice of the source code.
+    std::string_view get_name(std::uint32_t id) const {
+        return interner->get_name(id);
+    }
 
-    std::string get_string_value(Token token) const;
+    bool get_bool_value(Token token) const;
 
     SymbolTable &get_symbol_table() {
         return symbol_table;
     }
 
+    // Where the types of the attributes and of the symbol table are kept.
+    TypeTable &get_types() {
+        return types;
+    }
+
+    const TypeTable &get_types() const {
+        return types;
+    }
+
+#ifdef DEBUG
+    // Until it is NO_RULE again, get_attributes fails on the slots that
+    // rule_slots does not give for rule.
+    void set_running_rule(int rule) {
+        running_rule = rule;
+    }
+#endif
+
 private:
-    char _parse_rune(std::string lex, std::size_t &p) const;
+    void _remove_slot(Token token);
 
+    const Interner *interner;
     SymbolTable symbol_table;
-    std::stack<std::string> *lexemes;
-    std::vector<SymbolAttributes> *attributes;
+    TypeTable types;
+    std::stack<LiteralValue, std::vector<LiteralValue>> *literals;
+    std::stack<std::uint32_t, std::vector<std::uint32_t>> identifiers;
+    std::vector<std::uint32_t> *slots;
+    std::vector<SymbolAttributes> records;
+#ifdef DEBUG
+    int running_rule = NO_RULE;
+#endif
 };
 
 #endif //ALGO_RULE_CONTEXT_H
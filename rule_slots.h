@@ -0,0 +1,256 @@
+#ifndef ALGO_RULE_SLOTS_H
+#define ALGO_RULE_SLOTS_H
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "definitions.h"
+
+
+constexpr int NUM_OF_SEMANTIC_RULES = 136;
+
+
+// A slot as a rule asks RuleContext::get_attributes for it.
+struct RuleSlot {
+    constexpr RuleSlot(int symbol, int r_idx = 0) : symbol(symbol), r_idx(r_idx) { }
+
+    int symbol;
+    int r_idx;
+};
+
+
+// The slots a rule reads or writes. A copy reads all of the second one
+// and overwrites all of the first with it, and does nothing else.
+struct RuleSlots {
+    static constexpr int MAX_SLOTS = 4;
+
+    constexpr bool declares(int symbol, std::size_t r_idx) const {
+        for (int i = 0; i < count; ++i)
+            if (slots[i].symbol == symbol and (std::size_t)slots[i].r_idx == r_idx)
+                return true;
+        return false;
+    }
+
+    bool is_copy;
+    int count;
+    RuleSlot slots[MAX_SLOTS];
+};
+
+
+constexpr RuleSlots uses_slots(std::initializer_list<RuleSlot> slots) {
+    RuleSlots rule{false, 0, {0, 0, 0, 0}};
+    for (RuleSlot slot : slots)
+        rule.slots[rule.count++] = slot;
+    return rule;
+}
+
+constexpr RuleSlots copies_slot(RuleSlot to, RuleSlot from) {
+    return {true, 2, {to, from, 0, 0}};
+}
+
+
+// How a slot of an expanded production gets its record: a new one, the
+// head's, or else the one the production allocated after this many others.
+enum SlotRecord : std::int8_t {
+    OWN_RECORD = -1,
+    HEAD_RECORD = -2
+};
+
+
+// What rule i of semantic_rules touches, which is all the analysis in
+// slot_aliases.h knows of it. Debug builds check each access against it.
+constexpr RuleSlots rule_slots[] = {
+        // 0: const declaration
+        uses_slots({SyntaxSymbol::IDENT, SyntaxSymbol::TYPEp}),
+
+        // 1 to 11: set type
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+        uses_slots({SyntaxSymbol::TYPE}),
+
+        // 12 to 14: get int value
+        uses_slots({SyntaxSymbol::INT_LIT, SyntaxSymbol::DEC}),
+        uses_slots({SyntaxSymbol::INT_LIT, SyntaxSymbol::OCTAL}),
+        uses_slots({SyntaxSymbol::INT_LIT, SyntaxSymbol::HEXADEC}),
+
+        // 15: forward TYPEp attributes
+        uses_slots({SyntaxSymbol::TYPEp, {SyntaxSymbol::TYPEp, 1}, SyntaxSymbol::INT_LIT}),
+        // 16: copy-back TYPEp attributes
+        copies_slot({SyntaxSymbol::TYPEp, 1}, SyntaxSymbol::TYPEp),
+        // 17: copy-back attributes from TYPE to TYPEp
+        uses_slots({SyntaxSymbol::TYPEp, SyntaxSymbol::TYPE}),
+
+        // 18: variable declaration
+        uses_slots({SyntaxSymbol::IDENT, SyntaxSymbol::TYPEp}),
+        // 19: copy-back attributes from TYPEp to FUNC_DECLp
+        copies_slot(SyntaxSymbol::FUNC_DECLp, SyntaxSymbol::TYPEp),
+        // 20: declare function and create new scope
+        uses_slots({SyntaxSymbol::IDENT}),
+        // 21: set function params and return type
+        uses_slots({SyntaxSymbol::FUNC_DECLp, SyntaxSymbol::PARAM_LIST, SyntaxSymbol::BLOCK}),
+        // 22: end scope
+        uses_slots({}),
+
+        // 23: forward & add params from PARAM_LIST
+        uses_slots({SyntaxSymbol::IDENT, SyntaxSymbol::TYPEp, SyntaxSymbol::PARAM_LISTp, SyntaxSymbol::PARAM_LIST}),
+        // 24: forward/copy-back params
+        copies_slot(SyntaxSymbol::PARAM_LIST, SyntaxSymbol::PARAM_LISTp),
+        // 25: forward & add params from PARAM_LISTp
+        uses_slots({SyntaxSymbol::IDENT, SyntaxSymbol::TYPEp, SyntaxSymbol::PARAM_LISTp, {SyntaxSymbol::PARAM_LISTp, 1}}),
+        // 26: copy-back params
+        copies_slot({SyntaxSymbol::PARAM_LISTp, 1}, SyntaxSymbol::PARAM_LISTp),
+
+        // 27 to 39: return and loop information
+        uses_slots({SyntaxSymbol::BLOCK_CONTS, SyntaxSymbol::BLOCK}),
+        uses_slots({SyntaxSymbol::BLOCK_UNIT, SyntaxSymbol::BLOCK_CONTS}),
+        uses_slots({SyntaxSymbol::BLOCK_CONTS, {SyntaxSymbol::BLOCK_CONTS, 1}}),
+        uses_slots({SyntaxSymbol::IF_CONST, SyntaxSymbol::BLOCK_UNIT}),
+        uses_slots({SyntaxSymbol::BLOCK, SyntaxSymbol::IF_CONST}),
+        uses_slots({SyntaxSymbol::FOR_CONST, SyntaxSymbol::BLOCK_UNIT}),
+        uses_slots({SyntaxSymbol::BLOCK, SyntaxSymbol::FOR_CONST}),
+        uses_slots({SyntaxSymbol::BLOCK_UNIT, SyntaxSymbol::CONTINUE}),
+        uses_slots({SyntaxSymbol::BLOCK_UNIT, SyntaxSymbol::BREAK}),
+        uses_slots({SyntaxSymbol::IF_CONSTp, SyntaxSymbol::IF_CONST}),
+        uses_slots({SyntaxSymbol::ELSEp, SyntaxSymbol::IF_CONSTp}),
+        uses_slots({SyntaxSymbol::IF_CONST, SyntaxSymbol::ELSEp}),
+        uses_slots({SyntaxSymbol::BLOCK, SyntaxSymbol::ELSEp}),
+
+        // 40: create scope
+        uses_slots({}),
+        // 41: forward l_value and identifier
+        uses_slots({SyntaxSymbol::LV1EXPR, SyntaxSymbol::EXPRp}),
+        // 42: assignment
+        uses_slots({SyntaxSymbol::EXPRp, SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::EXPR}),
+        // 43: const declaration assignment
+        uses_slots({SyntaxSymbol::EXPR, SyntaxSymbol::ASSIGN}),
+
+        // 44 to 55: set operation
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::ASSIGN}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_PLUS}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_MINUS}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_TIMES}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_DIV}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_MOD}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_BW_AND}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_BW_AND_NOT}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_BW_OR}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_BW_XOR}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_L_SHIFT}),
+        uses_slots({SyntaxSymbol::ASSIGN_OPER, SyntaxSymbol::A_R_SHIFT}),
+
+        // 56 to 61: lv1expr
+        copies_slot(SyntaxSymbol::LV1EXPRp, SyntaxSymbol::LV2EXPR),
+        copies_slot(SyntaxSymbol::LV1EXPR, SyntaxSymbol::LV1EXPRp),
+        uses_slots({SyntaxSymbol::LV1EXPR, SyntaxSymbol::LV1OPER}),
+        uses_slots({SyntaxSymbol::LV1EXPR, SyntaxSymbol::LV2EXPR}),
+        copies_slot(SyntaxSymbol::LV1EXPRp, SyntaxSymbol::LV1EXPR),
+        uses_slots({SyntaxSymbol::LV1OPER, SyntaxSymbol::OR}),
+
+        // 62 to 67: lv2expr
+        copies_slot(SyntaxSymbol::LV2EXPRp, SyntaxSymbol::LV3EXPR),
+        copies_slot(SyntaxSymbol::LV2EXPR, SyntaxSymbol::LV2EXPRp),
+        uses_slots({SyntaxSymbol::LV2EXPR, SyntaxSymbol::LV2OPER}),
+        uses_slots({SyntaxSymbol::LV2EXPR, SyntaxSymbol::LV3EXPR}),
+        copies_slot(SyntaxSymbol::LV2EXPRp, SyntaxSymbol::LV2EXPR),
+        uses_slots({SyntaxSymbol::LV2OPER, SyntaxSymbol::AND}),
+
+        // 68 to 78: lv3expr
+        copies_slot(SyntaxSymbol::LV3EXPRp, SyntaxSymbol::LV4EXPR),
+        copies_slot(SyntaxSymbol::LV3EXPR, SyntaxSymbol::LV3EXPRp),
+        uses_slots({SyntaxSymbol::LV3EXPR, SyntaxSymbol::LV3OPER}),
+        uses_slots({SyntaxSymbol::LV3EXPR, SyntaxSymbol::LV4EXPR}),
+        copies_slot(SyntaxSymbol::LV3EXPRp, SyntaxSymbol::LV3EXPR),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::EQ}),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::NEQ}),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::LT}),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::GT}),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::LTE}),
+        uses_slots({SyntaxSymbol::LV3OPER, SyntaxSymbol::GTE}),
+
+        // 79 to 87: lv4expr
+        copies_slot(SyntaxSymbol::LV4EXPRp, SyntaxSymbol::LV5EXPR),
+        copies_slot(SyntaxSymbol::LV4EXPR, SyntaxSymbol::LV4EXPRp),
+        uses_slots({SyntaxSymbol::LV4EXPR, SyntaxSymbol::LV4OPER}),
+        uses_slots({SyntaxSymbol::LV4EXPR, SyntaxSymbol::LV5EXPR}),
+        copies_slot(SyntaxSymbol::LV4EXPRp, SyntaxSymbol::LV4EXPR),
+        uses_slots({SyntaxSymbol::LV4OPER, SyntaxSymbol::PLUS}),
+        uses_slots({SyntaxSymbol::LV4OPER, SyntaxSymbol::MINUS}),
+        uses_slots({SyntaxSymbol::LV4OPER, SyntaxSymbol::BW_OR}),
+        uses_slots({SyntaxSymbol::LV4OPER, SyntaxSymbol::BW_XOR_NEG}),
+
+        // 88: unary operation
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::TERM}),
+        // 89 to 100: lv5expr
+        copies_slot(SyntaxSymbol::LV5EXPRp, SyntaxSymbol::TERM),
+        copies_slot(SyntaxSymbol::LV5EXPR, SyntaxSymbol::LV5EXPRp),
+        uses_slots({SyntaxSymbol::LV5EXPR, SyntaxSymbol::LV5OPER}),
+        uses_slots({SyntaxSymbol::LV5EXPR, SyntaxSymbol::TERM}),
+        copies_slot(SyntaxSymbol::LV5EXPRp, SyntaxSymbol::LV5EXPR),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::TIMES}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::DIV}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::MOD}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::BW_AND}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::BW_AND_NOT}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::L_SHIFT}),
+        uses_slots({SyntaxSymbol::LV5OPER, SyntaxSymbol::R_SHIFT}),
+
+        // 101 to 106: set unary operator
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::PLUS}),
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::MINUS}),
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::BW_XOR_NEG}),
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::INCR}),
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::DECR}),
+        uses_slots({SyntaxSymbol::UNARYOPER, SyntaxSymbol::NOT}),
+
+        // 107: copy back at expr
+        copies_slot(SyntaxSymbol::EXPR, SyntaxSymbol::LV1EXPR),
+        // 108: get identifier info
+        uses_slots({SyntaxSymbol::IDENT}),
+
+        // 109 to 117: get literal info; true and false have no value to check
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::DEC}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::OCTAL}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::HEXADEC}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::FLOAT}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::RUNE}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::STRING}),
+        uses_slots({SyntaxSymbol::TERM, SyntaxSymbol::R_STRING}),
+        uses_slots({SyntaxSymbol::TERM}),
+        uses_slots({SyntaxSymbol::TERM}),
+
+        // 118 to 121: parenthesized expression and cast
+        copies_slot(SyntaxSymbol::TERM, SyntaxSymbol::LV1EXPR),
+        copies_slot(SyntaxSymbol::TERM, SyntaxSymbol::CAST),
+        copies_slot(SyntaxSymbol::CAST, SyntaxSymbol::LV1EXPR),
+        uses_slots({SyntaxSymbol::CAST, SyntaxSymbol::TYPE}),
+
+        // 122 to 131: access
+        copies_slot(SyntaxSymbol::ACCESS, SyntaxSymbol::IDENT),
+        copies_slot(SyntaxSymbol::FUNC_CALL, {SyntaxSymbol::ACCESS, 1}),
+        copies_slot(SyntaxSymbol::ARRAY_ACC, {SyntaxSymbol::ACCESS, 1}),
+        uses_slots({SyntaxSymbol::ACCESS}),
+        uses_slots({SyntaxSymbol::FUNC_CALL, SyntaxSymbol::O_PAREN}),
+        uses_slots({SyntaxSymbol::ARRAY_ACC, SyntaxSymbol::C_SQBRACK, SyntaxSymbol::LV1EXPR}),
+        copies_slot(SyntaxSymbol::ACCESS, SyntaxSymbol::FUNC_CALL),
+        copies_slot(SyntaxSymbol::ACCESS, SyntaxSymbol::ARRAY_ACC),
+        copies_slot({SyntaxSymbol::ACCESS, 1}, SyntaxSymbol::ACCESS),
+        copies_slot(SyntaxSymbol::TERM, SyntaxSymbol::ACCESS),
+
+        // 132 to 135: conditions
+        uses_slots({SyntaxSymbol::EXPR, SyntaxSymbol::IF}),
+        uses_slots({SyntaxSymbol::EXPR, SyntaxSymbol::SEMICOL, SyntaxSymbol::FOR_CONSTpp}),
+        uses_slots({SyntaxSymbol::FOR_CONSTpp}),
+        uses_slots({SyntaxSymbol::FOR_CONSTpp, SyntaxSymbol::EXPR, SyntaxSymbol::FOR}),
+};
+
+static_assert(sizeof(rule_slots) / sizeof(rule_slots[0]) == NUM_OF_SEMANTIC_RULES, "rule_slots misses a rule");
+
+#endif //ALGO_RULE_SLOTS_H
@@ -0,0 +1,71 @@
+#include "scan_kernels_impl.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+
+
+namespace {
+
+struct Sse2Vector {
+    typedef __m128i type;
+    static constexpr int width = 16;
+
+    static type load(const char *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+
+    static type set(char c) {
+        return _mm_set1_epi8(c);
+    }
+
+    static type eq(type v, char c) {
+        return _mm_cmpeq_epi8(v, set(c));
+    }
+
+    static type in_range(type v, char low, char high) {
+        type offset = _mm_sub_epi8(v, set(low));
+        return _mm_cmpeq_epi8(_mm_min_epu8(offset, set(char(high - low))), offset);
+    }
+
+    static type either(type a, type b) {
+        return _mm_or_si128(a, b);
+    }
+
+    static type both(type a, type b) {
+        return _mm_and_si128(a, b);
+    }
+
+    static type negate(type v) {
+        return _mm_xor_si128(v, _mm_set1_epi8(-1));
+    }
+
+    static std::uint32_t mask(type v) {
+        return (std::uint32_t)_mm_movemask_epi8(v);
+    }
+};
+
+}
+
+
+const ScanKernels &sse2_scan_kernels() {
+    static const ScanKernels kernels = make_scan_kernels<VectorScan<Sse2Vector>>("sse2");
+    return kernels;
+}
+#endif
+
+
+const ScanKernels &scalar_scan_kernels() {
+    static const ScanKernels kernels = make_scan_kernels<ScalarScan>("scalar");
+    return kernels;
+}
+
+
+const ScanKernels &scan_kernels() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const ScanKernels &kernels =
+            __builtin_cpu_supports("avx2") ? avx2_scan_kernels() : sse2_scan_kernels();
+#else
+    static const ScanKernels &kernels = scalar_scan_kernels();
+#endif
+    return kernels;
+}
@@ -0,0 +1,41 @@
+#ifndef ALGO_SCAN_KERNELS_H
+#define ALGO_SCAN_KERNELS_H
+
+#include <cstddef>
+
+
+// Routines skipping runs of characters that the lexical automaton would
+// otherwise consume one by one. Each one returns a pointer to the first
+// character in [p, end) that does not belong to the run.
+struct ScanKernels {
+    const char *name;
+
+    // Skips ' ', '\t' and '\n', adding the skipped line breaks to newlines.
+    const char *(*skip_white_space)(const char *p, const char *end, std::size_t &newlines);
+
+    // Letters, digits and '_'.
+    const char *(*identifier_end)(const char *p, const char *end);
+
+    const char *(*digits_end)(const char *p, const char *end);
+
+    // Printable characters other than '"' and '\\'.
+    const char *(*string_body_end)(const char *p, const char *end);
+
+    const char *(*find_char)(const char *p, const char *end, char c);
+
+    std::size_t (*count_newlines)(const char *p, const char *end);
+};
+
+
+// The fastest implementation supported by the running processor.
+const ScanKernels &scan_kernels();
+
+const ScanKernels &scalar_scan_kernels();
+
+#if defined(__x86_64__) || defined(__i386__)
+const ScanKernels &sse2_scan_kernels();
+
+const ScanKernels &avx2_scan_kernels();
+#endif
+
+#endif //ALGO_SCAN_KERNELS_H
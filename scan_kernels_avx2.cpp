@@ -0,0 +1,55 @@
+// Built with AVX2 enabled; only called after checking the processor for it.
+#include "scan_kernels_impl.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+
+namespace {
+
+struct Avx2Vector {
+    typedef __m256i type;
+    static constexpr int width = 32;
+
+    static type load(const char *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+
+    static type set(char c) {
+        return _mm256_set1_epi8(c);
+    }
+
+    static type eq(type v, char c) {
+        return _mm256_cmpeq_epi8(v, set(c));
+    }
+
+    static type in_range(type v, char low, char high) {
+        type offset = _mm256_sub_epi8(v, set(low));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, set(char(high - low))), offset);
+    }
+
+    static type either(type a, type b) {
+        return _mm256_or_si256(a, b);
+    }
+
+    static type both(type a, type b) {
+        return _mm256_and_si256(a, b);
+    }
+
+    static type negate(type v) {
+        return _mm256_xor_si256(v, _mm256_set1_epi8(-1));
+    }
+
+    static std::uint32_t mask(type v) {
+        return (std::uint32_t)_mm256_movemask_epi8(v);
+    }
+};
+
+}
+
+
+const ScanKernels &avx2_scan_kernels() {
+    static const ScanKernels kernels = make_scan_kernels<VectorScan<Avx2Vector>>("avx2");
+    return kernels;
+}
+#endif
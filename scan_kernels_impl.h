@@ -0,0 +1,157 @@
+#ifndef ALGO_SCAN_KERNELS_IMPL_H
+#define ALGO_SCAN_KERNELS_IMPL_H
+
+#include <cstdint>
+
+#include "scan_kernels.h"
+
+
+// Everything here is compiled once per instruction set, so it is kept out of
+// the reach of the linker: merging the AVX2 build of an inline function with
+// the baseline one could run AVX2 code on a processor without it.
+namespace {
+
+struct ScalarScan {
+    static bool is_white_space(char c) {
+        return c == ' ' or c == '\t' or c == '\n';
+    }
+
+    static bool is_identifier(char c) {
+        return (unsigned char)((c | 0x20) - 'a') < 26 or (unsigned char)(c - '0') < 10 or c == '_';
+    }
+
+    static bool is_digit(char c) {
+        return (unsigned char)(c - '0') < 10;
+    }
+
+    static bool is_string_body(char c) {
+        return (unsigned char)(c - 32) < 95 and c != '"' and c != '\\';
+    }
+
+    static const char *skip_white_space(const char *p, const char *end, std::size_t &newlines) {
+        for (; p != end and is_white_space(*p); ++p)
+            newlines += *p == '\n';
+        return p;
+    }
+
+    static const char *identifier_end(const char *p, const char *end) {
+        while (p != end and is_identifier(*p))
+            ++p;
+        return p;
+    }
+
+    static const char *digits_end(const char *p, const char *end) {
+        while (p != end and is_digit(*p))
+            ++p;
+        return p;
+    }
+
+    static const char *string_body_end(const char *p, const char *end) {
+        while (p != end and is_string_body(*p))
+            ++p;
+        return p;
+    }
+
+    static const char *find_char(const char *p, const char *end, char c) {
+        while (p != end and *p != c)
+            ++p;
+        return p;
+    }
+
+    static std::size_t count_newlines(const char *p, const char *end) {
+        std::size_t newlines = 0;
+        for (; p != end; ++p)
+            newlines += *p == '\n';
+        return newlines;
+    }
+};
+
+
+// Kernels over a vector type V providing width, load, eq, in_range, either,
+// both, negate and mask (one bit per byte, as with movemask). Inputs
+// shorter than a vector are finished with the scalar loops.
+template <typename V>
+struct VectorScan {
+    static constexpr std::uint32_t full_mask = V::width == 32 ? 0xffffffffu : (1u << V::width) - 1;
+
+    static std::uint32_t below(int n) {
+        return n >= 32 ? 0xffffffffu : (1u << n) - 1;
+    }
+
+    static const char *skip_white_space(const char *p, const char *end, std::size_t &newlines) {
+        for (; end - p >= V::width; p += V::width) {
+            auto v = V::load(p);
+            auto new_line = V::eq(v, '\n');
+            std::uint32_t new_lines = V::mask(new_line);
+            std::uint32_t stop = ~V::mask(V::either(V::either(V::eq(v, ' '), V::eq(v, '\t')), new_line)) &
+                                 full_mask;
+            if (stop) {
+                int run = __builtin_ctz(stop);
+                newlines += __builtin_popcount(new_lines & below(run));
+                return p + run;
+            }
+            newlines += __builtin_popcount(new_lines);
+        }
+        return ScalarScan::skip_white_space(p, end, newlines);
+    }
+
+    static const char *identifier_end(const char *p, const char *end) {
+        for (; end - p >= V::width; p += V::width) {
+            auto v = V::load(p);
+            auto letter = V::in_range(V::either(v, V::set(0x20)), 'a', 'z');
+            auto match = V::either(V::either(letter, V::in_range(v, '0', '9')), V::eq(v, '_'));
+            std::uint32_t stop = ~V::mask(match) & full_mask;
+            if (stop)
+                return p + __builtin_ctz(stop);
+        }
+        return ScalarScan::identifier_end(p, end);
+    }
+
+    static const char *digits_end(const char *p, const char *end) {
+        for (; end - p >= V::width; p += V::width) {
+            std::uint32_t stop = ~V::mask(V::in_range(V::load(p), '0', '9')) & full_mask;
+            if (stop)
+                return p + __builtin_ctz(stop);
+        }
+        return ScalarScan::digits_end(p, end);
+    }
+
+    static const char *string_body_end(const char *p, const char *end) {
+        for (; end - p >= V::width; p += V::width) {
+            auto v = V::load(p);
+            auto special = V::either(V::eq(v, '"'), V::eq(v, '\\'));
+            auto match = V::both(V::in_range(v, 32, 126), V::negate(special));
+            std::uint32_t stop = ~V::mask(match) & full_mask;
+            if (stop)
+                return p + __builtin_ctz(stop);
+        }
+        return ScalarScan::string_body_end(p, end);
+    }
+
+    static const char *find_char(const char *p, const char *end, char c) {
+        for (; end - p >= V::width; p += V::width) {
+            std::uint32_t found = V::mask(V::eq(V::load(p), c));
+            if (found)
+                return p + __builtin_ctz(found);
+        }
+        return ScalarScan::find_char(p, end, c);
+    }
+
+    static std::size_t count_newlines(const char *p, const char *end) {
+        std::size_t newlines = 0;
+        for (; end - p >= V::width; p += V::width)
+            newlines += __builtin_popcount(V::mask(V::eq(V::load(p), '\n')));
+        return newlines + ScalarScan::count_newlines(p, end);
+    }
+};
+
+
+template <typename Scan>
+ScanKernels make_scan_kernels(const char *name) {
+    return {name, Scan::skip_white_space, Scan::identifier_end, Scan::digits_end,
+            Scan::string_body_end, Scan::find_char, Scan::count_newlines};
+}
+
+}
+
+#endif //ALGO_SCAN_KERNELS_IMPL_H
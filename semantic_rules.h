@@ -2,41 +2,64 @@
 #define ALGO_SEMANTIC_RULES_H
 
 #include <exception>
-#include <functional>
-#include <sstream>
 #include <string>
-#include <vector>
+#include <string_view>
 
+#include "diagnostics.h"
 #include "rule_context.h"
+#include "rule_slots.h"
 
 
-typedef std::function<void(RuleContext &)> SemanticRule;
+typedef void (*SemanticRule)(RuleContext &);
 
 
-extern const std::vector<SemanticRule> semantic_rules;
+// Rule i is the one numbered i in productions.csv.
+extern const SemanticRule semantic_rules[NUM_OF_SEMANTIC_RULES];
+
+
+inline void apply_rule(RuleContext &context, int rule) {
+#ifdef DEBUG
+    context.set_running_rule(rule);
+    try {
+        semantic_rules[rule](context);
+    } catch (...) {
+        context.set_running_rule(RuleContext::NO_RULE);
+        throw;
+    }
+    context.set_running_rule(RuleContext::NO_RULE);
+#else
+    semantic_rules[rule](context);
+#endif
+}
+
+
+// Checks the binary operation of left, done at its line_no, on left and
+// right, and leaves the attributes of the result in right.
+void apply_operation(const RuleContext &context, const SymbolAttributes &left, SymbolAttributes &right);
 
 
 class SemanticError : public std::exception {
 public:
-    SemanticError(std::string error, std::size_t line_no) : line_no(line_no) {
-        std::stringstream ss;
-        ss << error << " at line " << line_no;
-        msg = ss.str();
-    }
+    // name, if the message has one, is a slice of the source code.
+    SemanticError(DiagnosticCode code, std::size_t line_no, std::string_view name = {}) :
+            diagnostic{code, 0, 0, (std::uint32_t)line_no, name} { }
 
     virtual ~SemanticError() {
     }
 
-    virtual const char *what() const throw() {
-        return msg.c_str();
+    // Formatted on first use.
+    virtual const char *what() const throw();
+
+    const Diagnostic &get_diagnostic() const {
+        return diagnostic;
     }
 
     std::size_t get_line_no() const {
-        return line_no;
+        return diagnostic.line_no;
     }
 private:
-    std::string msg;
-    std::size_t line_no;
+    Diagnostic diagnostic;
+    mutable std::string msg;
 };
 
 #endif //ALGO_SEMANTIC_RULES_H
@@ -0,0 +1,128 @@
+// Times parsing a file with the semantic rules called through the table of
+// function pointers against calling them through std::function objects
+// holding std::bind expressions, the way the analyzer used to.
+//
+//   semantic_rules_benchmark <file> [repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "command_line.h"
+#include "parse_stack.h"
+#include "semantic_rules.h"
+#include "token_buffer.h"
+
+
+using namespace std;
+
+
+struct ParseStats {
+    size_t rules;
+    size_t errors;
+};
+
+
+// The analyzer's loop, without error recovery, calling rule i through apply(i, context).
+template <typename Apply>
+static ParseStats parse(TokenBuffer &tokens, Apply apply) {
+    RuleContext context(tokens.get_interner());
+    ParseStack stack;
+    stack.push({SyntaxSymbol::NONE});
+    stack.push({SyntaxSymbol::PACKAGE});
+
+    ParseStats stats{0, 0};
+    size_t index = 0;
+    while (not stack.empty()) {
+        ProductionItem item = stack.top();
+        if (item.type() == ProductionItem::SYMBOL) {
+            SyntaxSymbol symbol{item.value()};
+            Token token = tokens.get_token(index);
+            if (symbol.is_terminal()) {
+                if (symbol != token)
+                    throw runtime_error("Syntax error at line " + to_string(tokens.get_line_no(index)));
+                stack.pop();
+                if (symbol == Token::NONE)
+                    break;
+                context.get_attributes(symbol).line_no = tokens.get_line_no(index);
+                if (symbol == Token::IDENT)
+                    context.set_identifier(tokens.get_identifier(index));
+                else if (symbol.is_literal())
+                    context.set_literal(symbol, tokens.get_literal(index));
+                ++index;
+            } else {
+                int production = grammar::parse_table[symbol - SyntaxSymbol::FIRST_NON_TERMINAL][token];
+                if (production == grammar::NO_PRODUCTION)
+                    throw runtime_error("Syntax error at line " + to_string(tokens.get_line_no(index)));
+                stack.pop();
+                int start = grammar::expansion_starts[production];
+                stack.push(grammar::expansion_items + start, grammar::expansion_starts[production + 1] - start);
+                start = grammar::symbol_starts[production];
+                context.add_symbols(grammar::expansion_symbols + start, grammar::symbol_starts[production + 1] - start);
+            }
+        } else if (item.type() == ProductionItem::RULE) {
+            try {
+                apply(item.value(), context);
+            } catch (SemanticError &) {
+                ++stats.errors;
+            }
+            ++stats.rules;
+            stack.pop();
+        } else {
+            int start = grammar::symbol_starts[item.value()];
+            context.remove_symbols(grammar::expansion_symbols + start,
+                                   grammar::symbol_starts[item.value() + 1] - start);
+            stack.pop();
+        }
+    }
+    return stats;
+}
+
+
+template <typename Apply>
+static double time_ms(TokenBuffer &tokens, Apply apply, ParseStats &stats) {
+    auto start = chrono::steady_clock::now();
+    stats = parse(tokens, apply);
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <file> [repetitions]" << endl;
+        return 1;
+    }
+    int repetitions = parse_repetitions(argc, argv, 2, 5);
+    if (repetitions == 0)
+        return 1;
+
+    SourceCode source_code(argv[1]);
+    TokenBuffer tokens(&source_code);
+
+    vector<function<void(RuleContext &)>> bound_rules;
+    for (SemanticRule rule : semantic_rules)
+        bound_rules.push_back(bind(rule, placeholders::_1));
+
+    // The two take turns, so that drift in the machine hits them alike,
+    // and the best run of each is kept.
+    ParseStats stats{}, bound_stats{};
+    double bound_ms = HUGE_VAL, static_ms = HUGE_VAL;
+    for (int i = 0; i < repetitions; ++i) {
+        bound_ms = min(bound_ms, time_ms(tokens, [&](int rule, RuleContext &context) {
+            bound_rules[rule](ref(context));
+        }, bound_stats));
+        static_ms = min(static_ms, time_ms(tokens, [](int rule, RuleContext &context) {
+            semantic_rules[rule](context);
+        }, stats));
+    }
+
+    cout << tokens.size() << " tokens, " << stats.rules << " rules, " << stats.errors << " semantic errors" << endl;
+    cout << "std::function     " << bound_ms << " ms" << endl;
+    cout << "function pointers " << static_ms << " ms (" << bound_ms / static_ms << "x)" << endl;
+    return 0;
+}
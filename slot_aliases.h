@@ -0,0 +1,332 @@
+#ifndef ALGO_SLOT_ALIASES_H
+#define ALGO_SLOT_ALIASES_H
+
+#include <array>
+#include <cstdint>
+
+#include "grammar.h"
+#include "rule_slots.h"
+
+
+// Copy rules elided at compile time. A copy rule only moves a record from
+// one slot of a production to another; if the two slots are never in use
+// at the same time, they can share one record and the copy does nothing.
+// That is decided here for the productions Analyzer::analyze expands, from
+// productions.csv and what rule_slots says each rule touches.
+namespace grammar {
+
+constexpr int NUM_OF_EXPANSION_ITEMS = expansion_starts[NUM_OF_PRODUCTIONS];
+
+// The productions without the copies, laid out as expansion_items and
+// expansion_starts, and the SlotRecord of each of expansion_symbols, for
+// RuleContext::add_symbols.
+struct SlotAliases {
+    std::array<ProductionItem, NUM_OF_EXPANSION_ITEMS> items;
+    std::array<int, NUM_OF_PRODUCTIONS + 1> starts;
+    std::array<std::int8_t, NUM_OF_EXPANSION_SYMBOLS> records;
+    int elided_copies;
+};
+
+
+namespace slot_analysis {
+
+constexpr int MAX_ITEMS = 16;
+// Slot 0 is the head, slot i + 1 the i-th symbol from the left.
+constexpr int MAX_SLOTS = MAX_ITEMS + 1;
+constexpr int UNRESOLVED = -1;
+constexpr int SEVERAL_HEADS = -2;
+
+constexpr bool fits() {
+    for (int production = 0; production < NUM_OF_PRODUCTIONS; ++production)
+        if (expansion_starts[production + 1] - expansion_starts[production] > MAX_ITEMS)
+            return false;
+    return true;
+}
+
+static_assert(fits(), "a production is longer than slot_analysis::MAX_ITEMS");
+
+
+// A production left to right, without its end marker.
+struct Production {
+    constexpr Production(int production) : num_items(0), items{}, num_symbols(0), symbols{} {
+        for (int i = expansion_starts[production + 1] - 1; i > expansion_starts[production]; --i) {
+            items[num_items++] = expansion_items[i];
+            if (expansion_items[i].type() == ProductionItem::SYMBOL)
+                symbols[num_symbols++] = expansion_items[i].value();
+        }
+    }
+
+    // The slot get_attributes(symbol, r_idx) gives a rule of the production
+    // when head is the symbol expanded: the leftmost occurrence of a symbol
+    // is the innermost.
+    constexpr int resolve(int head, RuleSlot slot) const {
+        int occurrence = 0;
+        for (int i = 0; i < num_symbols; ++i)
+            if (symbols[i] == slot.symbol and occurrence++ == slot.r_idx)
+                return i + 1;
+        return slot.symbol == head and slot.r_idx == occurrence ? 0 : UNRESOLVED;
+    }
+
+    int num_items;
+    ProductionItem items[MAX_ITEMS];
+    int num_symbols;
+    int symbols[MAX_ITEMS];
+};
+
+
+enum Access {
+    USE = 1,
+    DEFINE = 2,
+    UPDATE = USE | DEFINE
+};
+
+// How the item at time touches slot: a symbol touches its own slot, as
+// the productions expanding it do with their head, and a rule the slots
+// rule_slots gives it.
+constexpr int access(const Production &production, int head, int time, int slot) {
+    ProductionItem item = production.items[time];
+    if (item.type() == ProductionItem::SYMBOL) {
+        int symbol = 0;
+        for (int i = 0; i <= time; ++i)
+            symbol += production.items[i].type() == ProductionItem::SYMBOL;
+        if (symbol != slot)
+            return 0;
+        // The expression parser assigns the whole of it and reads none.
+        return item.value() == SyntaxSymbol::LV1EXPR ? DEFINE : UPDATE;
+    }
+    const RuleSlots &rule = rule_slots[item.value()];
+    if (rule.is_copy) {
+        return (production.resolve(head, rule.slots[1]) == slot ? USE : 0) |
+               (production.resolve(head, rule.slots[0]) == slot ? DEFINE : 0);
+    }
+    for (int i = 0; i < rule.count; ++i)
+        if (production.resolve(head, rule.slots[i]) == slot)
+            return UPDATE;
+    return 0;
+}
+
+
+// Where the value of a slot is live, on a time line with the reads at
+// 2 * time and the writes at 2 * time + 1. The record a slot starts with
+// is written at -2, and that of a head that may not be empty at -1.
+struct Liveness {
+    static constexpr int BIRTH = -2;
+    static constexpr int MAX_INTERVALS = 2 * MAX_ITEMS + 2;
+
+    constexpr Liveness() : num_intervals(0), from{}, to{}, num_dead(0), dead{} { }
+
+    constexpr Liveness(const Production &production, int head, bool fresh_head, int slot) :
+            num_intervals(0), from{}, to{}, num_dead(0), dead{} {
+        int defined = slot == 0 and not fresh_head ? -1 : BIRTH;
+        bool used = false;
+        for (int time = 0; time <= production.num_items; ++time) {
+            // After the production, its head is read by its parent.
+            int how = time < production.num_items ? access(production, head, time, slot) : slot == 0 ? USE : 0;
+            if (how & USE) {
+                from[num_intervals] = defined;
+                to[num_intervals++] = 2 * time;
+                used = true;
+            }
+            if (how & DEFINE) {
+                if (not used and defined != BIRTH)
+                    dead[num_dead++] = defined;
+                defined = 2 * time + 1;
+                used = false;
+            }
+        }
+        if (not used and defined != BIRTH)
+            dead[num_dead++] = defined;
+    }
+
+    constexpr bool covers(int point) const {
+        for (int i = 0; i < num_intervals; ++i)
+            if (from[i] <= point and point <= to[i])
+                return true;
+        return false;
+    }
+
+    constexpr bool overlaps(const Liveness &other) const {
+        for (int i = 0; i < num_intervals; ++i)
+            for (int j = 0; j < other.num_intervals; ++j)
+                if (from[i] <= other.to[j] and other.from[j] <= to[i])
+                    return true;
+        for (int i = 0; i < num_dead; ++i)
+            if (other.covers(dead[i]))
+                return true;
+        for (int i = 0; i < other.num_dead; ++i)
+            if (covers(other.dead[i]))
+                return true;
+        return false;
+    }
+
+    int num_intervals;
+    int from[MAX_INTERVALS];
+    int to[MAX_INTERVALS];
+    int num_dead;
+    int dead[MAX_INTERVALS];
+};
+
+
+constexpr bool is_non_terminal(int symbol) {
+    return symbol >= SyntaxSymbol::PACKAGE;
+}
+
+}
+
+
+constexpr SlotAliases make_slot_aliases() {
+    using namespace slot_analysis;
+
+    // The head of each production, and which ones Analyzer::analyze
+    // expands: those of the package, of the terms and unary operators the
+    // expression parser adds, and of what they lead to, LV1EXPR aside.
+    std::array<int, NUM_OF_PRODUCTIONS> heads{};
+    for (int &head : heads)
+        head = UNRESOLVED;
+    for (const auto &entry : syntactic_table_entries) {
+        int &head = heads[entry.production];
+        head = head == UNRESOLVED or head == entry.non_terminal ? entry.non_terminal : SEVERAL_HEADS;
+    }
+    std::array<bool, SyntaxSymbol::PACKAGE + NUM_OF_NON_TERMINALS> expanded{};
+    std::array<bool, NUM_OF_PRODUCTIONS> reachable{};
+    expanded[SyntaxSymbol::PACKAGE] = expanded[SyntaxSymbol::TERM] = expanded[SyntaxSymbol::UNARYOPER] = true;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto &entry : syntactic_table_entries) {
+            if (not expanded[entry.non_terminal] or reachable[entry.production])
+                continue;
+            reachable[entry.production] = changed = true;
+            for (int i = symbol_starts[entry.production]; i < symbol_starts[entry.production + 1]; ++i)
+                if (is_non_terminal(expansion_symbols[i]) and expansion_symbols[i] != SyntaxSymbol::LV1EXPR)
+                    expanded[expansion_symbols[i]] = true;
+        }
+    }
+
+    // Slots a rule reaches outside its own production are left alone.
+    std::array<bool, SyntaxSymbol::PACKAGE + NUM_OF_NON_TERMINALS> escapes{};
+    for (const auto &entry : syntactic_table_entries) {
+        if (not reachable[entry.production])
+            continue;
+        Production production(entry.production);
+        for (int time = 0; time < production.num_items; ++time) {
+            ProductionItem item = production.items[time];
+            if (item.type() != ProductionItem::RULE)
+                continue;
+            const RuleSlots &rule = rule_slots[item.value()];
+            for (int i = 0; i < rule.count; ++i)
+                if (production.resolve(entry.non_terminal, rule.slots[i]) == UNRESOLVED)
+                    escapes[rule.slots[i].symbol] = true;
+        }
+    }
+
+    // Whether a symbol is always expanded with an empty record: as its
+    // leftmost occurrence, which is its innermost slot, and before any rule
+    // of the production touches it. The analysis of that production keeps
+    // the record empty up to there, as the value the symbol starts with is
+    // live until then.
+    std::array<bool, SyntaxSymbol::PACKAGE + NUM_OF_NON_TERMINALS> fresh{};
+    for (int symbol = SyntaxSymbol::PACKAGE; symbol < SyntaxSymbol::PACKAGE + NUM_OF_NON_TERMINALS; ++symbol)
+        fresh[symbol] = not escapes[symbol];
+    for (int p = 0; p < NUM_OF_PRODUCTIONS; ++p) {
+        if (not reachable[p])
+            continue;
+        Production production(p);
+        int slot = 0;
+        for (int time = 0; time < production.num_items; ++time) {
+            if (production.items[time].type() != ProductionItem::SYMBOL)
+                continue;
+            int symbol = production.symbols[slot++];
+            if (not is_non_terminal(symbol))
+                continue;
+            if (production.resolve(heads[p], {symbol}) != slot) {
+                fresh[symbol] = false;
+                continue;
+            }
+            for (int before = 0; before < time; ++before)
+                if (access(production, heads[p], before, slot))
+                    fresh[symbol] = false;
+        }
+    }
+
+    SlotAliases aliases{};
+    for (auto &record : aliases.records)
+        record = OWN_RECORD;
+    int count = 0;
+    for (int p = 0; p < NUM_OF_PRODUCTIONS; ++p) {
+        aliases.starts[p] = count;
+        aliases.items[count++] = expansion_items[expansion_starts[p]];
+        Production production(p);
+        int head = heads[p];
+        bool elided[MAX_ITEMS]{};
+
+        if (reachable[p] and head >= 0) {
+            Liveness liveness[MAX_SLOTS];
+            for (int slot = 0; slot <= production.num_symbols; ++slot)
+                liveness[slot] = Liveness(production, head, fresh[head], slot);
+            // Slots sharing a record, by the smallest slot among them.
+            int group[MAX_SLOTS]{};
+            for (int slot = 0; slot <= production.num_symbols; ++slot)
+                group[slot] = slot;
+
+            for (int time = 0; time < production.num_items; ++time) {
+                ProductionItem item = production.items[time];
+                if (item.type() != ProductionItem::RULE or not rule_slots[item.value()].is_copy)
+                    continue;
+                const RuleSlots &rule = rule_slots[item.value()];
+                int to = production.resolve(head, rule.slots[0]);
+                int from = production.resolve(head, rule.slots[1]);
+                if (to == UNRESOLVED or from == UNRESOLVED or escapes[rule.slots[0].symbol] or
+                    escapes[rule.slots[1].symbol])
+                    continue;
+                int to_group = group[to], from_group = group[from];
+                bool disjoint = true;
+                for (int i = 0; i <= production.num_symbols; ++i)
+                    for (int j = 0; j <= production.num_symbols; ++j)
+                        if (to_group != from_group and group[i] == to_group and group[j] == from_group and
+                            liveness[i].overlaps(liveness[j]))
+                            disjoint = false;
+                if (not disjoint)
+                    continue;
+                int merged = to_group < from_group ? to_group : from_group;
+                for (int &slot_group : group)
+                    if (slot_group == to_group or slot_group == from_group)
+                        slot_group = merged;
+                elided[time] = true;
+                ++aliases.elided_copies;
+            }
+
+            // The records are allocated as expansion_symbols lists the
+            // slots, last symbol first; a group without the head has that
+            // of its first one.
+            int first = symbol_starts[p];
+            std::int8_t allocated = 0;
+            std::int8_t ordinal[MAX_ITEMS]{};
+            for (int i = 0; i < production.num_symbols; ++i) {
+                int slot = production.num_symbols - i;
+                if (group[slot] == 0) {
+                    aliases.records[first + i] = HEAD_RECORD;
+                    continue;
+                }
+                int owner = 0;
+                while (group[production.num_symbols - owner] != group[slot])
+                    ++owner;
+                if (owner == i)
+                    ordinal[i] = allocated++;
+                else
+                    aliases.records[first + i] = ordinal[owner];
+            }
+        }
+
+        for (int time = production.num_items - 1; time >= 0; --time)
+            if (not elided[time])
+                aliases.items[count++] = production.items[time];
+    }
+    aliases.starts[NUM_OF_PRODUCTIONS] = count;
+    return aliases;
+}
+
+constexpr auto slot_aliases = make_slot_aliases();
+
+}
+
+#endif //ALGO_SLOT_ALIASES_H
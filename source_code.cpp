@@ -1,25 +1,48 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
 #include "source_code.h"
 
 
 SourceCode::SourceCode(std::string filename) :
-        input(filename), buffer_position(0), buffer_length(0), finished(false) { }
-
+        data(nullptr), length(0), mapped(false) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat info;
+    if (fstat(fd, &info) == 0 and S_ISREG(info.st_mode)) {
+        length = (std::size_t)info.st_size;
+        if (length == 0) {
+            close(fd);
+            return;
+        }
+        void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, length, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(address);
+            mapped = true;
+            close(fd);
+            return;
+        }
+    }
+    close(fd);
 
-SourceCode::~SourceCode() { }
+    // Pipes and other unmappable inputs are read whole into memory instead.
+    std::ifstream input(filename);
+    std::stringstream ss;
+    ss << input.rdbuf();
+    fallback = ss.str();
+    data = fallback.data();
+    length = fallback.size();
+}
 
 
-bool SourceCode::get(char &c) {
-    if (buffer_position == buffer_length) {
-        if (finished)
-            return false;
-        input.read(buffer, sizeof buffer);
-        buffer_length = input.gcount();
-        if (buffer_length == 0)
-            return false;
-        if (buffer_length < sizeof buffer)
-            finished = true;
-        buffer_position = 0;
-    }
-    c = buffer[buffer_position++];
-    return true;
+SourceCode::~SourceCode() {
+    if (mapped)
+        munmap(const_cast<char *>(data), length);
 }
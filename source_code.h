@@ -1,7 +1,6 @@
 #ifndef ALGO_SOURCE_CODE_H
 #define ALGO_SOURCE_CODE_H
 
-#include <fstream>
 #include <string>
 
 
@@ -9,16 +8,29 @@ class SourceCode {
 public:
     SourceCode(std::string filename);
 
+    SourceCode(const SourceCode &) = delete;
+
+    SourceCode &operator=(const SourceCode &) = delete;
+
     virtual ~SourceCode();
 
-    bool get(char &c);
+    const char *begin() const {
+        return data;
+    }
+
+    const char *end() const {
+        return data + length;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
 
 private:
-    std::ifstream input;
-    char buffer[8192];
-    std::size_t buffer_position;
-    std::streamsize buffer_length;
-    bool finished;
+    const char *data;
+    std::size_t length;
+    bool mapped;
+    std::string fallback;
 };
 
 
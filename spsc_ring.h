@@ -0,0 +1,69 @@
+#ifndef ALGO_SPSC_RING_H
+#define ALGO_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread. Each side keeps a stale copy of the other side's index
+// and only reloads it when the ring looks full or empty, so in the steady
+// state neither touches the other's cache line.
+template <typename T>
+class SpscRing {
+public:
+    // The capacity is rounded up to a power of two.
+    explicit SpscRing(std::size_t capacity) : head(0), tail(0), cached_head(0), cached_tail(0) {
+        std::size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        items.resize(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // Producer side.
+    bool try_push(const T &item) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head == items.size()) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head == items.size())
+                return false;
+        }
+        items[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool try_pop(T &item) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail)
+                return false;
+        }
+        item = items[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> items;
+    std::size_t mask;
+
+    // Next item to pop, written by the consumer.
+    alignas(64) std::atomic<std::size_t> head;
+    // Next free item, written by the producer.
+    alignas(64) std::atomic<std::size_t> tail;
+    // The producer's view of head.
+    alignas(64) std::size_t cached_head;
+    // The consumer's view of tail.
+    alignas(64) std::size_t cached_tail;
+};
+
+#endif //ALGO_SPSC_RING_H
@@ -1,42 +1,29 @@
 #include "symbol_table.h"
 
 
-SymbolTable::SymbolTable() {
-    scopes.push({});
-}
+SymbolTable::SymbolTable() : scopes{0} { }
 
 
 void SymbolTable::start_scope() {
-    scopes.push({});
+    scopes.push_back((std::uint32_t)declarations.size());
 }
 
 
 void SymbolTable::end_scope() {
-    for (std::string symbol : scopes.top()) {
-        auto &symbol_stack = table[symbol];
-        symbol_stack.pop();
-        if (symbol_stack.empty())
-            table.erase(symbol);
-    }
-    scopes.pop();
-}
-
-
-bool SymbolTable::has_symbol(const std::string &symbol) {
-    return table.find(symbol) != table.end();
+    for (std::size_t i = declarations.size(); i > scopes.back(); --i)
+        innermost[declarations[i - 1].symbol] = declarations[i - 1].shadowed;
+    declarations.resize(scopes.back());
+    scopes.pop_back();
 }
 
 
-SymbolTableRecord &SymbolTable::get_record(const std::string &symbol) {
-    return table[symbol].top();
-}
-
-
-bool SymbolTable::add_symbol(const std::string &symbol) {
-    if (scopes.top().find(symbol) != scopes.top().end())
+bool SymbolTable::add_symbol(std::uint32_t symbol) {
+    if (symbol >= innermost.size())
+        innermost.resize(symbol + 1, NO_DECLARATION);
+    std::uint32_t shadowed = innermost[symbol];
+    if (shadowed != NO_DECLARATION and shadowed >= scopes.back())
         return false;
-    scopes.top().insert(symbol);
-    table[symbol].push(SymbolTableRecord{});
+    innermost[symbol] = (std::uint32_t)declarations.size();
+    declarations.push_back({symbol, shadowed, SymbolTableRecord{}});
     return true;
 }
-
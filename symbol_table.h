@@ -1,53 +1,69 @@
 #ifndef ALGO_SYMBOL_TABLE_H
 #define ALGO_SYMBOL_TABLE_H
 
-#include <set>
-#include <stack>
-#include <unordered_map>
+#include <cstdint>
 #include <vector>
 
 #include "definitions.h"
+#include "type_table.h"
 
 
+// Trivially copyable: types and parameter lists are ids in the TypeTable
+// of the RuleContext that made them.
 struct SymbolTableRecord {
-    explicit SymbolTableRecord(Type type=Type::VOID) :
-            type_dim(TypeDim{type}) {
-    }
-
-    struct TypeDim {
-        Type type;
-        std::vector<std::size_t> dimension;
+    TypeId type_dim = TypeTable::scalar(Type::VOID);
+    TypeId params = TypeTable::NO_PARAMETERS;
+    bool is_const = false;
+    bool is_function = false;
+    // The value of a literal; strings are not kept.
+    union {
+        bool bool_value;
+        long int_value = 0;
+        double float_value;
+        char rune_value;
     };
-
-    bool is_const;
-    bool is_function;
-    TypeDim type_dim;
-    bool bool_value;
-    long int_value;
-    double float_value;
-    char rune_value;
-    std::string str_value;
-    std::vector<TypeDim> params;
 };
 
 
+// Symbols are the interned ids of their names, which are dense, so the
+// innermost declaration of a symbol is found by indexing instead of
+// hashing. Declarations are kept in one vector in the order they are made,
+// each with the one it shadows, which makes it the undo log of the scopes
+// as well: ending a scope pops its declarations and puts back what they
+// shadowed. Nothing is allocated once the vectors have grown.
 class SymbolTable {
 public:
     explicit SymbolTable();
 
-    bool add_symbol(const std::string &symbol);
+    bool add_symbol(std::uint32_t symbol);
 
-    bool has_symbol(const std::string &symbol);
+    bool has_symbol(std::uint32_t symbol) const {
+        return symbol < innermost.size() and innermost[symbol] != NO_DECLARATION;
+    }
 
-    SymbolTableRecord &get_record(const std::string &symbol);
+    // Valid until the next add_symbol.
+    SymbolTableRecord &get_record(std::uint32_t symbol) {
+        return declarations[innermost[symbol]].record;
+    }
 
     void start_scope();
 
     void end_scope();
 
 private:
-    std::unordered_map<std::string, std::stack<SymbolTableRecord>> table;
-    std::stack<std::set<std::string>> scopes;
+    static constexpr std::uint32_t NO_DECLARATION = UINT32_MAX;
+
+    struct Declaration {
+        std::uint32_t symbol;
+        std::uint32_t shadowed;
+        SymbolTableRecord record;
+    };
+
+    // Index in declarations, by symbol.
+    std::vector<std::uint32_t> innermost;
+    std::vector<Declaration> declarations;
+    // Index of the first declaration of each scope.
+    std::vector<std::uint32_t> scopes;
 };
 
 #endif //ALGO_SYMBOL_TABLE_H
@@ -0,0 +1,57 @@
+// Times the full analysis of a file against the syntax-only recognizer, on
+// the same lexed tokens, and reports the throughput of each.
+//
+//   syntax_only_benchmark <file> [repetitions]
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "analyzer.h"
+#include "command_line.h"
+
+
+using namespace std;
+
+
+static double time_ms(TokenBuffer &tokens, int repetitions, bool syntax_only, bool &result) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        Analyzer analyzer(&tokens);
+        result = analyzer.analyze(syntax_only);
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+
+static void report(const char *name, double ms, const TokenBuffer &tokens, const SourceCode &source_code,
+                   bool result) {
+    cout << name << ms << " ms, " << tokens.size() / ms / 1e3 << " Mtokens/s, " <<
+            source_code.size() / ms / 1e3 << " MB/s" << (result ? "" : ", rejected") << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <file> [repetitions]" << endl;
+        return 1;
+    }
+    int repetitions = parse_repetitions(argc, argv, 2, 5);
+    if (repetitions == 0)
+        return 1;
+
+    SourceCode source_code(argv[1]);
+    TokenBuffer tokens(&source_code);
+    // The diagnostics are not what is being timed.
+    cerr.rdbuf(nullptr);
+
+    bool full_result, syntax_result;
+    double full_ms = time_ms(tokens, repetitions, false, full_result);
+    double syntax_ms = time_ms(tokens, repetitions, true, syntax_result);
+
+    cout << tokens.size() << " tokens, " << source_code.size() << " bytes" << endl;
+    report("full analysis ", full_ms, tokens, source_code, full_result);
+    report("syntax only   ", syntax_ms, tokens, source_code, syntax_result);
+    cout << full_ms / syntax_ms << "x" << endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "token_buffer.h"
+
+
+TokenBuffer::TokenBuffer(SourceCode *source_code) : TokenBuffer(source_code->size(), source_code) {
+    LexicalAnalyzer lexer(source_code, &interner);
+    _lex(lexer, source_code->end());
+}
+
+
+TokenBuffer::TokenBuffer(SourceCode *source_code, unsigned num_threads, std::size_t chunk_size) :
+        TokenBuffer(source_code->size(), source_code) {
+    const char *begin = source_code->begin(), *end = source_code->end();
+    chunk_size = std::max(chunk_size, std::size_t(1));
+
+    // Chunks start right after a line break, where a token is most likely
+    // to start too.
+    std::vector<const char *> starts{begin};
+    while (std::size_t(end - starts.back()) > chunk_size) {
+        auto line_end = (const char *)std::memchr(starts.back() + chunk_size, '\n',
+                                                  end - starts.back() - chunk_size);
+        if (line_end == nullptr or line_end + 1 == end)
+            break;
+        starts.push_back(line_end + 1);
+    }
+    std::vector<const char *> stops(starts.begin() + 1, starts.end());
+    stops.push_back(end);
+
+    // Every chunk interns identifiers on its own.
+    std::vector<std::unique_ptr<TokenBuffer>> chunks(starts.size());
+    std::deque<LexicalAnalyzer> lexers;
+    lexers.emplace_back(source_code, &interner, begin);
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+        chunks[i].reset(new TokenBuffer(stops[i] - starts[i], source_code));
+        lexers.emplace_back(source_code, &chunks[i]->interner, starts[i]);
+    }
+
+    // This thread lexes the first chunk, then helps with the rest.
+    std::atomic<std::size_t> next_chunk(1);
+    auto lex_chunks = [&chunks, &lexers, &stops, &next_chunk] {
+        for (std::size_t i; (i = next_chunk++) < chunks.size();)
+            chunks[i]->_lex(lexers[i], stops[i]);
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min<std::size_t>(num_threads, chunks.size()); ++i)
+        workers.emplace_back(lex_chunks);
+    _lex(lexers[0], stops[0]);
+    lex_chunks();
+    for (auto &worker : workers)
+        worker.join();
+
+    // The last token of the buffer is always the first one at or past the
+    // start of the next chunk. When that chunk has a token starting at the
+    // same offset, both lexers are in sync from there on; otherwise the
+    // lexer of the buffer goes on until they are, or past the chunk.
+    LexicalAnalyzer *lexer = &lexers[0];
+    long line_delta = 0;
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+        while (kinds.back() != Token::NONE) {
+            std::size_t first = chunks[i]->_find(offsets.back());
+            if (first != chunks[i]->size()) {
+                line_delta = (long)lines.back() - (long)chunks[i]->lines[first];
+                std::vector<std::uint32_t> ids(chunks[i]->interner.size(), UINT32_MAX);
+                _pop();
+                _append(*chunks[i], first, line_delta, ids);
+                lexer = &lexers[i];
+                lexer->set_interner(&interner);
+                break;
+            }
+            if (offsets.back() >= std::size_t(stops[i] - begin))
+                break;
+            _lex_next(*lexer, line_delta);
+        }
+    }
+}
+
+
+TokenBuffer::TokenBuffer(SourceCode *source_code, unsigned num_threads) :
+        TokenBuffer(source_code, num_threads,
+                    std::max(source_code->size() / std::max(num_threads, 1u), MIN_CHUNK_SIZE)) { }
+
+
+TokenBuffer::TokenBuffer(std::size_t source_size, SourceCode *source_code) : source_code(source_code) {
+    if (source_code->size() > UINT32_MAX)
+        throw std::length_error("Source code too large for a token buffer.");
+
+    // Tokens of ordinary code average well above four characters.
+    std::size_t expected = source_size / 4 + 1;
+    kinds.reserve(expected);
+    offsets.reserve(expected);
+    lengths.reserve(expected);
+    lines.reserve(expected);
+    payloads.reserve(expected);
+}
+
+
+TokenBuffer::~TokenBuffer() { }
+
+
+void TokenBuffer::_lex(LexicalAnalyzer &lexer, const char *stop) {
+    std::size_t stop_offset = stop - source_code->begin();
+    do
+        _lex_next(lexer, 0);
+    while (kinds.back() != Token::NONE and offsets.back() < stop_offset);
+}
+
+
+void TokenBuffer::_lex_next(LexicalAnalyzer &lexer, long line_delta) {
+    _push(lexer.next(), line_delta);
+    lexer.take_decoded_strings(decoded_strings);
+}
+
+
+std::size_t TokenBuffer::_find(std::size_t offset) const {
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), offset);
+    if (it == offsets.end() or *it != offset)
+        return size();
+    return it - offsets.begin();
+}
+
+
+void TokenBuffer::_append(TokenBuffer &chunk, std::size_t first, long line_delta,
+                          std::vector<std::uint32_t> &ids) {
+    kinds.insert(kinds.end(), chunk.kinds.begin() + first, chunk.kinds.end());
+    offsets.insert(offsets.end(), chunk.offsets.begin() + first, chunk.offsets.end());
+    lengths.insert(lengths.end(), chunk.lengths.begin() + first, chunk.lengths.end());
+    for (std::size_t i = first; i < chunk.size(); ++i) {
+        lines.push_back((std::uint32_t)(chunk.lines[i] + line_delta));
+        Token token = chunk.kinds[i];
+        std::uint32_t payload = chunk.payloads[i];
+        if (token == Token::IDENT) {
+            if (ids[payload] == UINT32_MAX)
+                ids[payload] = interner.intern(chunk.interner.get_name(payload));
+            payload = ids[payload];
+        } else if (token.is_literal()) {
+            payload = (std::uint32_t)literals.size();
+            literals.push_back(chunk.literals[chunk.payloads[i]]);
+        }
+        payloads.push_back(payload);
+    }
+    decoded_strings.splice(decoded_strings.end(), chunk.decoded_strings);
+}
+
+
+void TokenBuffer::_pop() {
+    if (get_token(size() - 1).is_literal())
+        literals.pop_back();
+    payloads.pop_back();
+    kinds.pop_back();
+    offsets.pop_back();
+    lengths.pop_back();
+    lines.pop_back();
+}
+
+
+void TokenBuffer::_push(const LexicalDescriptor &descriptor, long line_delta) {
+    kinds.push_back((std::uint8_t)descriptor.get_token());
+    offsets.push_back((std::uint32_t)(descriptor.get_lexeme().data() - source_code->begin()));
+    lengths.push_back((std::uint32_t)descriptor.get_lexeme().size());
+    lines.push_back((std::uint32_t)(descriptor.get_line_no() + line_delta));
+    if (descriptor.get_token().is_literal()) {
+        payloads.push_back((std::uint32_t)literals.size());
+        literals.push_back(descriptor.get_literal());
+    } else {
+        payloads.push_back(descriptor.get_identifier());
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef ALGO_TOKEN_BUFFER_H
+#define ALGO_TOKEN_BUFFER_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "interner.h"
+#include "lexical_analyzer.h"
+#include "literal.h"
+
+
+// The whole token stream of a source code, lexed up front and stored as
+// parallel arrays. The last token is always Token::NONE. Each token has a
+// payload: the interned id of identifiers, or the index of literals in a
+// side table of values decoded once.
+class TokenBuffer {
+public:
+    explicit TokenBuffer(SourceCode *source_code);
+
+    static constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+    // Splits the source code at line breaks into chunks of about chunk_size
+    // bytes and lexes them on up to num_threads threads. Each chunk but the
+    // first is lexed assuming it does not start inside a comment or a
+    // string; the chunks are then stitched together, relexing wherever the
+    // guess was wrong, so the result is the same as with a single thread.
+    TokenBuffer(SourceCode *source_code, unsigned num_threads, std::size_t chunk_size);
+
+    // The same with a chunk per thread, of at least MIN_CHUNK_SIZE bytes.
+    TokenBuffer(SourceCode *source_code, unsigned num_threads);
+
+    TokenBuffer(const TokenBuffer &) = delete;
+
+    TokenBuffer &operator=(const TokenBuffer &) = delete;
+
+    virtual ~TokenBuffer();
+
+    std::size_t size() const {
+        return kinds.size();
+    }
+
+    Token get_token(std::size_t i) const {
+        return kinds[i];
+    }
+
+    std::string_view get_lexeme(std::size_t i) const {
+        return std::string_view(source_code->begin() + offsets[i], lengths[i]);
+    }
+
+    std::size_t get_offset(std::size_t i) const {
+        return offsets[i];
+    }
+
+    std::size_t get_line_no(std::size_t i) const {
+        return lines[i];
+    }
+
+    LexicalDescriptor get_descriptor(std::size_t i) const {
+        if (get_token(i).is_literal())
+            return {get_token(i), get_lexeme(i), get_line_no(i), get_literal(i)};
+        return {get_token(i), get_lexeme(i), get_line_no(i), get_token(i) == Token::IDENT ? payloads[i] : 0};
+    }
+
+    // Only for tokens that are literals.
+    const LiteralValue &get_literal(std::size_t i) const {
+        return literals[payloads[i]];
+    }
+
+    // Only for identifiers.
+    std::uint32_t get_identifier(std::size_t i) const {
+        return payloads[i];
+    }
+
+    Interner *get_interner() {
+        return &interner;
+    }
+
+private:
+    // An empty buffer with room for the tokens of source_size bytes.
+    TokenBuffer(std::size_t source_size, SourceCode *source_code);
+
+    // Appends the tokens of lexer up to the first one starting at stop or
+    // later, which is included.
+    void _lex(LexicalAnalyzer &lexer, const char *stop);
+
+    // Appends the next token of lexer, with its line moved by line_delta.
+    void _lex_next(LexicalAnalyzer &lexer, long line_delta);
+
+    // Index of the token starting at offset, or size() if there is none.
+    std::size_t _find(std::size_t offset) const;
+
+    // Appends the tokens of a chunk from index first on. Identifiers are
+    // interned again, as they are met, through ids mapping the ids of the
+    // chunk to the ones of this buffer.
+    void _append(TokenBuffer &chunk, std::size_t first, long line_delta, std::vector<std::uint32_t> &ids);
+
+    void _pop();
+
+    void _push(const LexicalDescriptor &descriptor, long line_delta);
+
+    SourceCode *source_code;
+    std::vector<std::uint8_t> kinds;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> lengths;
+    std::vector<std::uint32_t> lines;
+    std::vector<std::uint32_t> payloads;
+
+    Interner interner;
+    std::vector<LiteralValue> literals;
+    // Strings whose escape sequences had to be decoded; a list so that
+    // literals keep pointing to them while it grows or takes the ones of
+    // other buffers.
+    std::list<std::string> decoded_strings;
+};
+
+#endif //ALGO_TOKEN_BUFFER_H
@@ -0,0 +1,139 @@
+// Lexes files on several threads at many chunk sizes, down to a line per
+// chunk, and checks that the stitched token buffers are the same as the one
+// lexed on a single thread: kinds, offsets, lengths, lines and payloads.
+// Without files, checks a generated one whose lines break inside block
+// comments, raw strings and string literals, where seams are the hardest.
+//
+//   token_buffer_check [file...]
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "token_buffer.h"
+
+
+using namespace std;
+
+
+static const char *const PIECES[] = {
+        "package p;\n",
+        "var x int = 42;\n",
+        "x = x + 0x1f * 017 - 3.5e2;\n",
+        "s = \"a string /* not a comment */ // nor this\";\n",
+        "s = \"escapes \\\" \\\\ \\n \\t\";\n",
+        "s = \"a quote \\\" then `a back quote`\";\n",
+        "r = 'a'; r = '\\n'; r = '\\'';\n",
+        "/* a block comment\n\"with a string\"\nand `a raw one`\n*/\n",
+        "/* stars ** and slashes // inside\n * */ x = 1;\n",
+        "/*\n*\n/\n**/\n",
+        "t = `a raw string\n/* with a comment */\n\"and quotes\"\n`;\n",
+        "t = `\n\n`;\n",
+        "// a line comment with /* and \" and `\n",
+        "if x <= 10 && !b { x <<= 2; } else { x &^= 1; }\n",
+        "func f(a int, b [3][4]float64) bool { return a != 0; }\n",
+        "bad = 09 @ 1.e $;\n",
+        "\n",
+        "    \t\n",
+};
+
+
+static string generated(size_t pieces, unsigned seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<size_t> piece(0, sizeof(PIECES) / sizeof(PIECES[0]) - 1);
+    string code;
+    for (size_t i = 0; i < pieces; ++i)
+        code += PIECES[piece(random)];
+    // Ends inside a comment that is never closed.
+    return code + "x = 1;\n/* open\n\"\n`\n";
+}
+
+
+static bool same_literal(Token token, const LiteralValue &value, const LiteralValue &other) {
+    if (value.out_of_range != other.out_of_range or value.string_value != other.string_value)
+        return false;
+    if (token == Token::FLOAT)
+        return memcmp(&value.float_value, &other.float_value, sizeof(double)) == 0;
+    if (token == Token::RUNE)
+        return value.rune_value == other.rune_value;
+    return token == Token::STRING or token == Token::R_STRING or value.int_value == other.int_value;
+}
+
+
+// Describes the first difference between the buffers, or returns "".
+static string difference(TokenBuffer &expected, TokenBuffer &tokens) {
+    for (size_t i = 0; i < min(expected.size(), tokens.size()); ++i) {
+        string at = "token " + to_string(i) + " at offset " + to_string(expected.get_offset(i)) + ": ";
+        Token token = expected.get_token(i);
+        if (tokens.get_token(i) != token)
+            return at + "kind";
+        if (tokens.get_offset(i) != expected.get_offset(i))
+            return at + "offset";
+        if (tokens.get_lexeme(i).size() != expected.get_lexeme(i).size())
+            return at + "length";
+        if (tokens.get_line_no(i) != expected.get_line_no(i))
+            return at + "line";
+        if (token == Token::IDENT) {
+            if (tokens.get_identifier(i) != expected.get_identifier(i) or
+                tokens.get_interner()->get_name(tokens.get_identifier(i)) !=
+                expected.get_interner()->get_name(expected.get_identifier(i)))
+                return at + "identifier";
+        } else if (token.is_literal()) {
+            if (not same_literal(token, expected.get_literal(i), tokens.get_literal(i)))
+                return at + "literal";
+        }
+    }
+    if (tokens.size() != expected.size())
+        return "size " + to_string(tokens.size()) + " instead of " + to_string(expected.size());
+    return "";
+}
+
+
+static bool check(const string &filename) {
+    SourceCode source_code(filename);
+    TokenBuffer expected(&source_code);
+
+    // Every size up to a few lines, then doubling past the whole file.
+    vector<size_t> chunk_sizes;
+    for (size_t size = 1; size <= 256; ++size)
+        chunk_sizes.push_back(size);
+    for (size_t size = 512; size < source_code.size() * 2; size *= 2)
+        chunk_sizes.push_back(size);
+
+    for (unsigned threads : {1u, 4u}) {
+        for (size_t chunk_size : chunk_sizes) {
+            TokenBuffer tokens(&source_code, threads, chunk_size);
+            string diff = difference(expected, tokens);
+            if (not diff.empty()) {
+                cout << filename << ": " << threads << " threads, chunks of " << chunk_size << " bytes: " <<
+                        diff << endl;
+                return false;
+            }
+        }
+    }
+    cout << filename << ": " << expected.size() << " tokens, " << chunk_sizes.size() << " chunk sizes, ok" << endl;
+    return true;
+}
+
+
+int main(int argc, char *argv[]) {
+    bool ok = true;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i)
+            ok = check(argv[i]) and ok;
+        return ok ? 0 : 1;
+    }
+
+    string filename = (filesystem::temp_directory_path() / "token_buffer_check.algo").string();
+    for (unsigned seed = 1; seed <= 8; ++seed) {
+        ofstream(filename) << generated(400, seed);
+        ok = check(filename) and ok;
+    }
+    remove(filename.c_str());
+    return ok ? 0 : 1;
+}
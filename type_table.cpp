@@ -0,0 +1,65 @@
+#include "type_table.h"
+
+
+TypeTable::TypeTable() : slots(64, 0) {
+    for (TypeId id = 0; id <= NO_PARAMETERS; ++id)
+        nodes.push_back({id, 0, 0, id < NO_PARAMETERS ? Type(id) : Type::VOID});
+}
+
+
+TypeTable::~TypeTable() { }
+
+
+TypeId TypeTable::rebase(TypeId type, Type base) {
+    if (nodes[type].size == 0)
+        return scalar(base);
+    return add_dimension(rebase(nodes[type].parent, base), nodes[type].item);
+}
+
+
+bool TypeTable::same_dimensions(TypeId type, TypeId other) const {
+    if (nodes[type].size != nodes[other].size)
+        return false;
+    for (; nodes[type].size != 0; type = nodes[type].parent, other = nodes[other].parent)
+        if (nodes[type].item != nodes[other].item)
+            return false;
+    return true;
+}
+
+
+std::size_t TypeTable::_hash(TypeId parent, std::uint64_t item) {
+    std::uint64_t hash = (item ^ (std::uint64_t)parent << 40) * 0x9e3779b97f4a7c15u;
+    return (std::size_t)(hash ^ hash >> 29);
+}
+
+
+TypeId TypeTable::_intern(TypeId parent, std::uint64_t item) {
+    std::size_t mask = slots.size() - 1;
+    std::size_t i = _hash(parent, item) & mask;
+    for (; slots[i]; i = (i + 1) & mask) {
+        const Node &node = nodes[slots[i] - 1];
+        if (node.parent == parent and node.item == item)
+            return slots[i] - 1;
+    }
+
+    TypeId id = (TypeId)nodes.size();
+    nodes.push_back({parent, nodes[parent].size + 1, item, nodes[parent].base});
+    // Kept at most half full.
+    if (nodes.size() * 2 > slots.size())
+        _grow();
+    else
+        slots[i] = id + 1;
+    return id;
+}
+
+
+void TypeTable::_grow() {
+    slots.assign(slots.size() * 2, 0);
+    std::size_t mask = slots.size() - 1;
+    for (TypeId id = NO_PARAMETERS + 1; id < nodes.size(); ++id) {
+        std::size_t i = _hash(nodes[id].parent, nodes[id].item) & mask;
+        while (slots[i])
+            i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef ALGO_TYPE_TABLE_H
+#define ALGO_TYPE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "definitions.h"
+
+
+// Id of a type, dimensions included, or of a list of parameter types.
+typedef std::uint32_t TypeId;
+
+
+// Hash-conses the types of a file: each type, and each list of parameter
+// types, is made once, so two are equal if and only if their ids are.
+// A type with dimensions is the type with one dimension less and the
+// length of its last one; a list, the list without its last parameter and
+// that one. Either way, dropping the last item is following a link.
+//
+// Ids stay valid for as long as the table, and a copy of the table gives
+// the same ids to the types they already had.
+class TypeTable {
+public:
+    // The ids of the types without dimensions are their Type; the empty
+    // parameter list follows.
+    static constexpr TypeId NO_PARAMETERS = (TypeId)Type::STRING + 1;
+
+    explicit TypeTable();
+
+    virtual ~TypeTable();
+
+    static constexpr TypeId scalar(Type type) {
+        return (TypeId)type;
+    }
+
+    Type base(TypeId type) const {
+        return nodes[type].base;
+    }
+
+    // Number of dimensions of a type, or of parameters of a list.
+    std::size_t size(TypeId id) const {
+        return nodes[id].size;
+    }
+
+    bool is_array(TypeId type) const {
+        return nodes[type].size != 0;
+    }
+
+    // The type with a last dimension of length added.
+    TypeId add_dimension(TypeId type, std::size_t length) {
+        return _intern(type, length);
+    }
+
+    // Only for arrays: the type without its last dimension.
+    TypeId remove_dimension(TypeId type) const {
+        return nodes[type].parent;
+    }
+
+    // The type with the dimensions of type, of base.
+    TypeId rebase(TypeId type, Type base);
+
+    // Whether the types have the same dimensions, whatever their base.
+    bool same_dimensions(TypeId type, TypeId other) const;
+
+    TypeId add_parameter(TypeId parameters, TypeId type) {
+        return _intern(parameters, type);
+    }
+
+private:
+    struct Node {
+        TypeId parent;
+        std::uint32_t size;
+        // Length of the last dimension, or type of the last parameter.
+        std::uint64_t item;
+        Type base;
+    };
+
+    static std::size_t _hash(TypeId parent, std::uint64_t item);
+
+    TypeId _intern(TypeId parent, std::uint64_t item);
+
+    void _grow();
+
+    std::vector<Node> nodes;
+    // Open addressing with linear probing; slots hold id + 1, 0 when empty.
+    // Types without dimensions and the empty list are not in there.
+    std::vector<std::uint32_t> slots;
+};
+
+#endif //ALGO_TYPE_TABLE_H